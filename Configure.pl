@@ -449,6 +449,7 @@ build::probe::C_type_bool(\%config, \%defaults);
 build::probe::computed_goto(\%config, \%defaults);
 build::probe::pthread_yield(\%config, \%defaults);
 build::probe::rdtscp(\%config, \%defaults);
+build::probe::io_uring(\%config, \%defaults);
 
 my $order = $config{be} ? 'big endian' : 'little endian';
 
@@ -460,6 +460,37 @@ EOT
     $config->{has_pthread_yield} = $has_pthread_yield || 0
 }
 
+sub io_uring {
+    my ($config) = @_;
+    my $restore = _to_probe_dir();
+    _spew('try.c', <<'EOT');
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#ifndef __NR_io_uring_setup
+#error "no io_uring syscalls"
+#endif
+
+/* We only check that we can build against it here; whether the kernel lets
+ * us use it is found out at runtime. */
+int main(int argc, char **argv) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    if (p.features & IORING_FEAT_RW_CUR_POS)
+        return (int)syscall(__NR_io_uring_enter, 0, 0, 0, 0, NULL, 0);
+    return EXIT_SUCCESS;
+}
+EOT
+
+    print ::dots('    probing io_uring support');
+    my $has_io_uring = compile($config, 'try');
+    print $has_io_uring ? "YES\n": "NO\n";
+    $config->{has_io_uring} = $has_io_uring || 0
+}
+
 sub win32_compiler_toolchain {
     my ($config) = @_;
     my $has_nmake = 0 == system('nmake /? >NUL 2>&1');
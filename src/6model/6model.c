@@ -21,6 +21,18 @@ static MVMObject * get_method_cache(MVMThreadContext *tc, MVMSTable *st) {
    return st->method_cache;
 }
 
+/* Looks up a method in the method cache (which must be concrete), going
+ * through the dispatch table if it can have one. Gives VMNull if there is
+ * no such method. */
+static MVMObject * method_cache_lookup(MVMThreadContext *tc, MVMSTable *st, MVMObject *cache, MVMString *name) {
+    MVMMethodTable *table = MVM_6model_method_table_get(tc, st);
+    if (table) {
+        MVMObject *meth = MVM_6model_method_table_lookup(tc, table, name);
+        return meth ? meth : tc->instance->VMNull;
+    }
+    return MVM_repr_at_key_o(tc, cache, name);
+}
+
 /* Locates a method by name, checking in the method cache only. */
 MVMObject * MVM_6model_find_method_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMString *name) {
     MVMObject *cache;
@@ -30,7 +42,7 @@ MVMObject * MVM_6model_find_method_cache_only(MVMThreadContext *tc, MVMObject *o
     });
 
     if (cache && IS_CONCRETE(cache))
-        return MVM_repr_at_key_o(tc, cache, name);
+        return method_cache_lookup(tc, STABLE(obj), cache, name);
     return NULL;
 }
 
@@ -98,7 +110,7 @@ void MVM_6model_find_method(MVMThreadContext *tc, MVMObject *obj, MVMString *nam
     });
 
     if (cache && IS_CONCRETE(cache)) {
-        MVMObject *meth = MVM_repr_at_key_o(tc, cache, name);
+        MVMObject *meth = method_cache_lookup(tc, STABLE(obj), cache, name);
         if (!MVM_is_null(tc, meth)) {
             res->o = meth;
             return;
@@ -213,7 +225,7 @@ MVMint64 MVM_6model_can_method_cache_only(MVMThreadContext *tc, MVMObject *obj,
     });
 
     if (cache && IS_CONCRETE(cache)) {
-        MVMObject *meth = MVM_repr_at_key_o(tc, cache, name);
+        MVMObject *meth = method_cache_lookup(tc, STABLE(obj), cache, name);
         if (!MVM_is_null(tc, meth)) {
             return 1;
         }
@@ -464,6 +476,7 @@ void MVM_6model_stable_gc_free(MVMThreadContext *tc, MVMSTable *st) {
     MVM_free(st->invocation_spec);
     MVM_free(st->boolification_spec);
     MVM_free(st->debug_name);
+    MVM_6model_method_table_release(tc, st);
 }
 
 /* Get the next type cache ID for a newly created STable. */
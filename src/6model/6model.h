@@ -36,6 +36,11 @@
  * parametric type. */
 #define MVM_PARAMETERIZED_TYPE              32
 
+/* This STable mode flag is set if the method cache was set by setmethcache,
+ * which makes a new hash that nothing else refers to or changes; lookups in
+ * such a method cache can go through a method dispatch table. */
+#define MVM_METHOD_CACHE_PUBLISHED          64
+
 /* HLL type roles. */
 #define MVM_HLL_ROLE_NONE                   0
 #define MVM_HLL_ROLE_INT                    1
@@ -268,6 +273,11 @@ struct MVMSTable {
     /* By-name method dispatch cache. */
     MVMObject *method_cache;
 
+    /* Dispatch table built from the method cache, if it was published, and
+     * the method cache it was built for (so we notice a new one). */
+    MVMMethodTable *method_table;
+    MVMObject      *method_table_cache;
+
     /* An ID solely for use in caches that last a VM instance. Thus it
      * should never, ever be serialized and you should NEVER make a
      * type directory based upon this ID. Otherwise you'll create memory
@@ -0,0 +1,172 @@
+#include "moar.h"
+
+/* Mixes a method name hash code into the hash of a set of names; the order
+ * the names are seen in does not matter. */
+static MVMuint32 mix_name_hash(MVMuint32 hash) {
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/* Computes the hash of the method names of a method cache. */
+static MVMuint32 fingerprint(MVMHashBody *body) {
+    MVMHashEntry *current, *tmp;
+    unsigned      bucket_tmp;
+    MVMuint32     result = HASH_CNT(hash_handle, body->hash_head);
+    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
+        result += mix_name_hash(current->hash_handle.hashv);
+    }
+    return result;
+}
+
+/* Finds the slot for an entry in a table being built. */
+static MVMMethodTableSlot * find_slot(MVMMethodTable *table, MVMuint32 hash) {
+    MVMuint32 i = hash & table->mask;
+    while (table->slots[i].entry)
+        i = (i + 1) & table->mask;
+    return &(table->slots[i]);
+}
+
+/* Builds a dispatch table from a method cache. We keep the table at most
+ * half full. */
+static MVMMethodTable * build(MVMThreadContext *tc, MVMObject *cache, MVMuint32 print) {
+    MVMHashBody    *body  = &((MVMHash *)cache)->body;
+    MVMMethodTable *table = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa, sizeof(MVMMethodTable));
+    MVMHashEntry   *current, *tmp;
+    unsigned        bucket_tmp;
+    MVMuint32       num_slots = 8;
+    table->num_methods = HASH_CNT(hash_handle, body->hash_head);
+    while (num_slots < table->num_methods * 2)
+        num_slots *= 2;
+    table->mask        = num_slots - 1;
+    table->fingerprint = print;
+    table->source      = cache;
+    table->slots       = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        num_slots * sizeof(MVMMethodTableSlot));
+    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
+        MVMMethodTableSlot *slot = find_slot(table, current->hash_handle.hashv);
+        slot->hash  = current->hash_handle.hashv;
+        slot->entry = current;
+    }
+    return table;
+}
+
+/* Checks if a table has exactly the methods in a method cache. */
+static MVMint32 same_methods(MVMThreadContext *tc, MVMMethodTable *table, MVMObject *cache) {
+    MVMHashBody  *body = &((MVMHash *)cache)->body;
+    MVMHashEntry *current, *tmp;
+    unsigned      bucket_tmp;
+    if (table->num_methods != HASH_CNT(hash_handle, body->hash_head))
+        return 0;
+    HASH_ITER(hash_handle, body->hash_head, current, tmp, bucket_tmp) {
+        MVMObject *method = MVM_6model_method_table_lookup(tc, table,
+            (MVMString *)current->hash_handle.key);
+        if (method != current->value)
+            return 0;
+    }
+    return 1;
+}
+
+/* Drops a reference to a table, freeing it if it was the last one. Must be
+ * called with the method tables mutex held. If other threads may still be
+ * looking at the table, it is freed at the next safepoint. */
+static void release(MVMThreadContext *tc, MVMMethodTable *table, MVMint32 at_safepoint) {
+    MVMMethodTable **link;
+    size_t           slots_size;
+    if (--table->refs)
+        return;
+    link = &(tc->instance->method_tables[table->fingerprint % MVM_METHOD_TABLE_BUCKETS]);
+    while (*link != table)
+        link = &((*link)->next);
+    *link = table->next;
+    slots_size = (table->mask + 1) * sizeof(MVMMethodTableSlot);
+    if (at_safepoint) {
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, slots_size, table->slots);
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, sizeof(MVMMethodTable), table);
+    }
+    else {
+        MVM_fixed_size_free(tc, tc->instance->fsa, slots_size, table->slots);
+        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMMethodTable), table);
+    }
+}
+
+/* Gets the dispatch table for an STable whose method cache has already been
+ * deserialized, building it (or finding a table to share) if needed. Returns
+ * NULL if the method cache was not published, so can't have a table. Once
+ * built, this needs no lock: a table is in place before the STable says
+ * which method cache it is for, and a replaced table is freed at the next
+ * safepoint. */
+MVMMethodTable * MVM_6model_method_table_get(MVMThreadContext *tc, MVMSTable *st) {
+    MVMObject       *cache = st->method_cache;
+    MVMMethodTable  *table, *old_table;
+    MVMMethodTable **bucket;
+    MVMuint32        print;
+    if (!(st->mode_flags & MVM_METHOD_CACHE_PUBLISHED) || !cache || !IS_CONCRETE(cache)
+            || REPR(cache)->ID != MVM_REPR_ID_MVMHash)
+        return NULL;
+    if (st->method_table_cache == cache) {
+        MVM_barrier();
+        return st->method_table;
+    }
+
+    /* Nothing here allocates, so the GC can't run while we hold the mutex;
+     * see if another thread beat us to it, then look for a table with the
+     * same methods, or build one. */
+    uv_mutex_lock(&tc->instance->mutex_method_tables);
+    if (st->method_table_cache == cache) {
+        table = st->method_table;
+        uv_mutex_unlock(&tc->instance->mutex_method_tables);
+        return table;
+    }
+    print  = fingerprint(&((MVMHash *)cache)->body);
+    bucket = &(tc->instance->method_tables[print % MVM_METHOD_TABLE_BUCKETS]);
+    for (table = *bucket; table; table = table->next)
+        if (table->fingerprint == print && same_methods(tc, table, cache))
+            break;
+    if (!table) {
+        table       = build(tc, cache, print);
+        table->next = *bucket;
+        *bucket     = table;
+    }
+    table->refs++;
+
+    /* Install it, and let go of any table for an earlier method cache. */
+    old_table        = st->method_table;
+    st->method_table = table;
+    MVM_barrier();
+    MVM_ASSIGN_REF(tc, &(st->header), st->method_table_cache, cache);
+    if (old_table)
+        release(tc, old_table, 1);
+    uv_mutex_unlock(&tc->instance->mutex_method_tables);
+    return table;
+}
+
+/* Called when an STable is freed, to let go of its dispatch table. */
+void MVM_6model_method_table_release(MVMThreadContext *tc, MVMSTable *st) {
+    if (st->method_table) {
+        uv_mutex_lock(&tc->instance->mutex_method_tables);
+        release(tc, st->method_table, 0);
+        uv_mutex_unlock(&tc->instance->mutex_method_tables);
+        st->method_table = NULL;
+    }
+}
+
+/* Frees all dispatch tables. */
+void MVM_6model_method_table_destroy_all(MVMThreadContext *tc) {
+    MVMMethodTable **tables = tc->instance->method_tables;
+    MVMuint32        i;
+    for (i = 0; i < MVM_METHOD_TABLE_BUCKETS; i++) {
+        while (tables[i]) {
+            MVMMethodTable *table = tables[i];
+            tables[i] = table->next;
+            MVM_fixed_size_free(tc, tc->instance->fsa,
+                (table->mask + 1) * sizeof(MVMMethodTableSlot), table->slots);
+            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMMethodTable), table);
+        }
+    }
+    MVM_free(tables);
+    tc->instance->method_tables = NULL;
+}
@@ -0,0 +1,64 @@
+/* A compact, immutable method dispatch table, built on first use from a
+ * published method cache (one set with setmethcache, which is a hash only
+ * the STable refers to and which never changes). It is an open addressing
+ * table of the hash entries, keyed on the hash code of the method name, so
+ * a lookup is a probe or two rather than a walk of a uthash bucket chain.
+ * Types with identical method sets share a table. */
+struct MVMMethodTable {
+    /* The method cache hash the entries point into. Kept alive through the
+     * instance's table of method tables. */
+    MVMObject *source;
+
+    /* Number of methods, and the number of slots less one. */
+    MVMuint32 num_methods;
+    MVMuint32 mask;
+
+    /* Hash of the method names, used to find tables to share. */
+    MVMuint32 fingerprint;
+
+    /* Number of STables using the table. */
+    MVMuint32 refs;
+
+    /* Next table in the same bucket of the instance's table of tables. */
+    MVMMethodTable *next;
+
+    /* The slots; NULL entries are empty. */
+    MVMMethodTableSlot *slots;
+};
+
+/* A slot in a method dispatch table. */
+struct MVMMethodTableSlot {
+    /* Hash code of the method name. */
+    MVMuint32 hash;
+
+    /* The method cache entry, holding the name and the method. */
+    MVMHashEntry *entry;
+};
+
+/* Number of buckets in the instance's table of method tables. */
+#define MVM_METHOD_TABLE_BUCKETS 256
+
+MVMMethodTable * MVM_6model_method_table_get(MVMThreadContext *tc, MVMSTable *st);
+void MVM_6model_method_table_release(MVMThreadContext *tc, MVMSTable *st);
+void MVM_6model_method_table_destroy_all(MVMThreadContext *tc);
+
+/* Looks up a method by name in a dispatch table, returning NULL if there is
+ * no such method. */
+MVM_STATIC_INLINE MVMObject * MVM_6model_method_table_lookup(MVMThreadContext *tc,
+        MVMMethodTable *table, MVMString *name) {
+    MVMuint32 hash, i;
+    if (!name->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, name);
+    hash = (MVMuint32)name->body.cached_hash_code;
+    i    = hash & table->mask;
+    while (table->slots[i].entry) {
+        if (table->slots[i].hash == hash) {
+            MVMHashEntry *entry = table->slots[i].entry;
+            MVMString    *key   = (MVMString *)entry->hash_handle.key;
+            if (key == name || MVM_string_equal(tc, key, name))
+                return entry->value;
+        }
+        i = (i + 1) & table->mask;
+    }
+    return NULL;
+}
@@ -12,6 +12,7 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
         MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
         MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
         st->size = sizeof(MVMConcBlockingQueue);
+        st->REPR_data = MVM_calloc(1, sizeof(MVMConcBlockingQueueREPRData));
     });
 
     return st->WHAT;
@@ -19,23 +20,39 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
 
 /* Initializes a new instance. */
 static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
-    MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueBody     *cbq       = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueREPRData *repr_data = (MVMConcBlockingQueueREPRData *)st->REPR_data;
 
     /* Initialize locks. */
     int init_stat;
     cbq->locks = MVM_calloc(1, sizeof(MVMConcBlockingQueueLocks));
-    if ((init_stat = uv_mutex_init(&cbq->locks->head_lock)) < 0)
+    if ((init_stat = uv_mutex_init(&cbq->locks->lock)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
             uv_strerror(init_stat));
-    if ((init_stat = uv_mutex_init(&cbq->locks->tail_lock)) < 0)
-        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+    if ((init_stat = uv_cond_init(&cbq->locks->not_empty)) < 0)
+        MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
             uv_strerror(init_stat));
-    if ((init_stat = uv_cond_init(&cbq->locks->head_cond)) < 0)
+    if ((init_stat = uv_cond_init(&cbq->locks->not_full)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
             uv_strerror(init_stat));
 
-    /* Head and tail point to a null node. */
-    cbq->tail = cbq->head = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
+    if (repr_data && repr_data->capacity) {
+        /* Bounded; each slot starts out ready to be pushed to at the position
+         * that is its index. */
+        MVMuint64 i;
+        cbq->capacity = repr_data->capacity;
+        cbq->slots    = MVM_malloc(cbq->capacity * sizeof(MVMConcBlockingQueueSlot));
+        for (i = 0; i < cbq->capacity; i++) {
+            cbq->slots[i].seq   = (AO_t)i;
+            cbq->slots[i].value = NULL;
+        }
+    }
+    else {
+        /* Unbounded; head and tail point to a null node. */
+        MVMConcBlockingQueueNode *node = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+            sizeof(MVMConcBlockingQueueNode));
+        cbq->tail = cbq->head = node;
+    }
 }
 
 /* Copies the body of one object to another. */
@@ -46,12 +63,22 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 /* Called by the VM to mark any GCable items. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     /* At this point we know the world is stopped, and thus we can safely do a
-     * traversal of the data structure without needing locks. */
+     * traversal of the data structure without needing locks. Nothing can be
+     * half way through a push or take either, since those never contain a GC
+     * safe point. */
     MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *cur = cbq->head;
-    while (cur) {
-        MVM_gc_worklist_add(tc, worklist, &cur->value);
-        cur = cur->next;
+    if (cbq->slots) {
+        MVMuint64 i;
+        for (i = 0; i < cbq->capacity; i++)
+            if (cbq->slots[i].value)
+                MVM_gc_worklist_add(tc, worklist, &cbq->slots[i].value);
+    }
+    else {
+        MVMConcBlockingQueueNode *cur = cbq->head;
+        while (cur) {
+            MVM_gc_worklist_add(tc, worklist, &cur->value);
+            cur = cur->next;
+        }
     }
 }
 
@@ -59,23 +86,166 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)obj;
 
-    /* First, free all the nodes. */
+    /* First, free all the nodes or the slots. */
     MVMConcBlockingQueueNode *cur = cbq->body.head;
     while (cur) {
         MVMConcBlockingQueueNode *next = cur->next;
-        MVM_free(cur);
+        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode), cur);
         cur = next;
     }
     cbq->body.head = cbq->body.tail = NULL;
+    MVM_free(cbq->body.slots);
+    cbq->body.slots = NULL;
 
     /* Clean up locks. */
-    uv_mutex_destroy(&cbq->body.locks->head_lock);
-    uv_mutex_destroy(&cbq->body.locks->tail_lock);
-    uv_cond_destroy(&cbq->body.locks->head_cond);
+    uv_mutex_destroy(&cbq->body.locks->lock);
+    uv_cond_destroy(&cbq->body.locks->not_empty);
+    uv_cond_destroy(&cbq->body.locks->not_full);
     MVM_free(cbq->body.locks);
     cbq->body.locks = NULL;
 }
 
+/* Frees the REPR data. */
+static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
+    MVM_free(st->REPR_data);
+}
+
+/* Tries to add a value to the queue without blocking. Always succeeds for
+ * an unbounded queue; for a bounded one, returns zero if it is full. There
+ * is no GC safe point in here. */
+static int try_push(MVMThreadContext *tc, MVMObject *root, MVMConcBlockingQueueBody *cbq,
+                    MVMObject *to_add) {
+    if (cbq->slots) {
+        /* Claim the slot at the push position, if it has been emptied since
+         * the last time round the ring. */
+        MVMConcBlockingQueueSlot *slot;
+        AO_t pos = MVM_load(&cbq->push_pos);
+        while (1) {
+            MVMint64 diff;
+            slot = &(cbq->slots[pos % cbq->capacity]);
+            diff = (MVMint64)(MVM_load(&slot->seq) - pos);
+            if (diff == 0) {
+                if (MVM_cas(&cbq->push_pos, pos, pos + 1) == pos)
+                    break;
+                pos = MVM_load(&cbq->push_pos);
+            }
+            else if (diff < 0) {
+                return 0;
+            }
+            else {
+                pos = MVM_load(&cbq->push_pos);
+            }
+        }
+
+        /* Fill it and publish it to takers. */
+        MVM_ASSIGN_REF(tc, &(root->header), slot->value, to_add);
+        MVM_incr(&cbq->elems);
+        MVM_store(&slot->seq, pos + 1);
+        return 1;
+    }
+    else {
+        /* Link a new node after the tail, helping along any other push that
+         * linked its node but did not yet swing the tail. The count goes up
+         * first so it can never be seen to go below zero. */
+        MVMConcBlockingQueueNode *add = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+            sizeof(MVMConcBlockingQueueNode));
+        add->next = NULL;
+        MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
+        MVM_incr(&cbq->elems);
+        while (1) {
+            MVMConcBlockingQueueNode *tail = (MVMConcBlockingQueueNode *)MVM_load(&cbq->tail);
+            MVMConcBlockingQueueNode *next = (MVMConcBlockingQueueNode *)MVM_load(&tail->next);
+            if (tail != (MVMConcBlockingQueueNode *)MVM_load(&cbq->tail))
+                continue;
+            if (next == NULL) {
+                if (MVM_casptr(&tail->next, NULL, add) == NULL) {
+                    MVM_casptr(&cbq->tail, tail, add);
+                    return 1;
+                }
+            }
+            else {
+                MVM_casptr(&cbq->tail, tail, next);
+            }
+        }
+    }
+}
+
+/* Tries to take a value from the queue without blocking, returning NULL if
+ * it is empty. There is no GC safe point in here. */
+static MVMObject * try_take(MVMThreadContext *tc, MVMConcBlockingQueueBody *cbq) {
+    MVMObject *value;
+    if (cbq->slots) {
+        /* Claim the slot at the take position, if it has been filled. */
+        MVMConcBlockingQueueSlot *slot;
+        AO_t pos = MVM_load(&cbq->take_pos);
+        while (1) {
+            MVMint64 diff;
+            slot = &(cbq->slots[pos % cbq->capacity]);
+            diff = (MVMint64)(MVM_load(&slot->seq) - (pos + 1));
+            if (diff == 0) {
+                if (MVM_cas(&cbq->take_pos, pos, pos + 1) == pos)
+                    break;
+                pos = MVM_load(&cbq->take_pos);
+            }
+            else if (diff < 0) {
+                return NULL;
+            }
+            else {
+                pos = MVM_load(&cbq->take_pos);
+            }
+        }
+
+        /* Empty it and make it ready for the push one time round the ring
+         * from now. */
+        value = slot->value;
+        slot->value = NULL;
+        MVM_decr(&cbq->elems);
+        MVM_store(&slot->seq, pos + cbq->capacity);
+        return value;
+    }
+    else {
+        /* Move the head along to the node after it, whose value we take; it
+         * then becomes the null node. The old head may still be looked at by
+         * a thread that lost the race, so it is only freed once all threads
+         * have been to a safe point. */
+        while (1) {
+            MVMConcBlockingQueueNode *head = (MVMConcBlockingQueueNode *)MVM_load(&cbq->head);
+            MVMConcBlockingQueueNode *tail = (MVMConcBlockingQueueNode *)MVM_load(&cbq->tail);
+            MVMConcBlockingQueueNode *next = (MVMConcBlockingQueueNode *)MVM_load(&head->next);
+            if (head != (MVMConcBlockingQueueNode *)MVM_load(&cbq->head))
+                continue;
+            if (head == tail) {
+                if (next == NULL)
+                    return NULL;
+                MVM_casptr(&cbq->tail, tail, next);
+            }
+            else {
+                value = next->value;
+                if (MVM_casptr(&cbq->head, head, next) == head) {
+                    next->value = NULL;
+                    MVM_decr(&cbq->elems);
+                    MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                        sizeof(MVMConcBlockingQueueNode), head);
+                    return value;
+                }
+            }
+        }
+    }
+}
+
+/* Wakes up a thread sleeping on the specified condition, if there are any.
+ * This may block, so anything the caller needs must be rooted. */
+static void wake_waiter(MVMThreadContext *tc, MVMConcBlockingQueueLocks *locks,
+                        AO_t *waiters, uv_cond_t *cond) {
+    if (MVM_load(waiters)) {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&locks->lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        uv_cond_signal(cond);
+        uv_mutex_unlock(&locks->lock);
+    }
+}
+
 static const MVMStorageSpec storage_spec = {
     MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
     0,                          /* bits */
@@ -90,9 +260,23 @@ static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *
     return &storage_spec;
 }
 
-/* Compose the representation. */
-static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
-    /* Nothing to do for this REPR. */
+/* Compose the representation; a capacity may be given, in which case the
+ * queue is bounded. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
+    MVMStringConsts               str_consts = tc->instance->str_consts;
+    MVMConcBlockingQueueREPRData *repr_data  = (MVMConcBlockingQueueREPRData *)st->REPR_data;
+
+    MVMObject *info = MVM_repr_at_key_o(tc, info_hash, str_consts.queue);
+    if (!MVM_is_null(tc, info)) {
+        MVMObject *capacity = MVM_repr_at_key_o(tc, info, str_consts.capacity);
+        if (!MVM_is_null(tc, capacity)) {
+            MVMint64 value = MVM_repr_get_int(tc, capacity);
+            if (value < 0)
+                MVM_exception_throw_adhoc(tc,
+                    "ConcBlockingQueue capacity must not be negative (got %"PRId64")", value);
+            repr_data->capacity = (MVMuint64)value;
+        }
+    }
 }
 
 static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
@@ -105,25 +289,25 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
         MVM_exception_throw_adhoc(tc,
             "Can only get objects from a concurrent blocking queue");
 
+    /* Nodes are not freed before a safe point, so this is safe to do without
+     * locking; of course, the value may be taken by the time we return. */
+    value->o = NULL;
     if (MVM_load(&cbq->elems) > 0) {
-        MVMConcBlockingQueueNode *peeked;
-        unsigned int interval_id;
-        interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.at_pos");
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-            data = OBJECT_BODY(root);
-            cbq = (MVMConcBlockingQueueBody *)data;
-        });
-        peeked = cbq->head->next;
-        value->o = peeked ? peeked->value : tc->instance->VMNull;
-        uv_mutex_unlock(&cbq->locks->head_lock);
-        MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.at_pos");
+        if (cbq->slots) {
+            AO_t pos = MVM_load(&cbq->take_pos);
+            MVMConcBlockingQueueSlot *slot = &(cbq->slots[pos % cbq->capacity]);
+            if (MVM_load(&slot->seq) == pos + 1)
+                value->o = slot->value;
+        }
+        else {
+            MVMConcBlockingQueueNode *head = (MVMConcBlockingQueueNode *)MVM_load(&cbq->head);
+            MVMConcBlockingQueueNode *peeked = (MVMConcBlockingQueueNode *)MVM_load(&head->next);
+            if (peeked)
+                value->o = peeked->value;
+        }
     }
-    else {
+    if (!value->o)
         value->o = tc->instance->VMNull;
-    }
 }
 
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
@@ -132,11 +316,9 @@ static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
 }
 
 static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
-    MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *add;
-    AO_t orig_elems;
-    MVMObject *to_add = value.o;
-    unsigned int interval_id;
+    MVMConcBlockingQueueBody  *cbq    = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueLocks *locks  = cbq->locks;
+    MVMObject                 *to_add = value.o;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc,
@@ -145,76 +327,81 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
         MVM_exception_throw_adhoc(tc,
             "Cannot store a null value in a concurrent blocking queue");
 
-    add = MVM_calloc(1, sizeof(MVMConcBlockingQueueNode));
-
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.push");
-    MVMROOT(tc, root, {
-    MVMROOT(tc, to_add, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->tail_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
-    });
-    data = OBJECT_BODY(root);
-    cbq = (MVMConcBlockingQueueBody *)data;
-    MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
-    cbq->tail->next = add;
-    cbq->tail = add;
-    orig_elems = MVM_incr(&cbq->elems);
-    uv_mutex_unlock(&cbq->locks->tail_lock);
-
-    if (orig_elems == 0) {
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&cbq->locks->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
-        data = OBJECT_BODY(root);
-        cbq = (MVMConcBlockingQueueBody *)data;
-        uv_cond_signal(&cbq->locks->head_cond);
-        uv_mutex_unlock(&cbq->locks->head_lock);
+    if (!try_push(tc, root, cbq, to_add)) {
+        /* The queue is bounded and full. Spin a little in the hope a taker
+         * makes space, and then sleep until one does. */
+        MVMuint32 tries = 0;
+        while (tries < MVM_CBQ_SPIN_TRIES && !try_push(tc, root, cbq, to_add))
+            tries++;
+        if (tries == MVM_CBQ_SPIN_TRIES) {
+            unsigned int interval_id = MVM_telemetry_interval_start(tc,
+                "ConcBlockingQueue.push wait");
+            MVMROOT(tc, root, {
+            MVMROOT(tc, to_add, {
+                MVM_gc_mark_thread_blocked(tc);
+                uv_mutex_lock(&locks->lock);
+                MVM_gc_mark_thread_unblocked(tc);
+                MVM_incr(&locks->push_waiters);
+                cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+                while (!try_push(tc, root, cbq, to_add)) {
+                    MVM_gc_mark_thread_blocked(tc);
+                    uv_cond_wait(&locks->not_full, &locks->lock);
+                    MVM_gc_mark_thread_unblocked(tc);
+                    cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+                }
+                MVM_decr(&locks->push_waiters);
+                uv_mutex_unlock(&locks->lock);
+            });
+            });
+            MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.push wait");
+        }
     }
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.push");
+
+    wake_waiter(tc, locks, &locks->shift_waiters, &locks->not_empty);
 }
 
 static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
-    MVMConcBlockingQueueBody *cbq = (MVMConcBlockingQueueBody *)data;
-    MVMConcBlockingQueueNode *taken;
-    unsigned int interval_id;
+    MVMConcBlockingQueueBody  *cbq   = (MVMConcBlockingQueueBody *)data;
+    MVMConcBlockingQueueLocks *locks = cbq->locks;
+    MVMObject                 *taken;
+    MVMuint32                  tries = 0;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc, "Can only shift objects from a ConcBlockingQueue");
 
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.shift");
-    MVMROOT(tc, root, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-        data = OBJECT_BODY(root);
-        cbq  = (MVMConcBlockingQueueBody *)data;
-
-        while (MVM_load(&cbq->elems) == 0) {
+    /* Spin a little in the hope a value turns up, and then sleep until one
+     * does. */
+    while (!(taken = try_take(tc, cbq)) && tries < MVM_CBQ_SPIN_TRIES)
+        tries++;
+    if (!taken) {
+        unsigned int interval_id = MVM_telemetry_interval_start(tc,
+            "ConcBlockingQueue.shift wait");
+        MVMROOT(tc, root, {
+            MVM_gc_mark_thread_blocked(tc);
+            uv_mutex_lock(&locks->lock);
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_incr(&locks->shift_waiters);
+            cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+            while (!(taken = try_take(tc, cbq))) {
                 MVM_gc_mark_thread_blocked(tc);
-                uv_cond_wait(&cbq->locks->head_cond, &cbq->locks->head_lock);
+                uv_cond_wait(&locks->not_empty, &locks->lock);
                 MVM_gc_mark_thread_unblocked(tc);
-                data = OBJECT_BODY(root);
-                cbq  = (MVMConcBlockingQueueBody *)data;
-        }
-    });
-
-    taken = cbq->head->next;
-    MVM_free(cbq->head);
-    cbq->head = taken;
-    MVM_barrier();
-    value->o = taken->value;
-    taken->value = NULL;
-    MVM_barrier();
+                cbq = (MVMConcBlockingQueueBody *)OBJECT_BODY(root);
+            }
+            MVM_decr(&locks->shift_waiters);
+            uv_mutex_unlock(&locks->lock);
+        });
+        MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift wait");
+    }
 
-    if (MVM_decr(&cbq->elems) > 1)
-        uv_cond_signal(&cbq->locks->head_cond);
+    /* If there was no space, there may be a pusher waiting for some. */
+    if (cbq->slots) {
+        MVMROOT(tc, taken, {
+            wake_waiter(tc, locks, &locks->push_waiters, &locks->not_full);
+        });
+    }
 
-    uv_mutex_unlock(&cbq->locks->head_lock);
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift");
+    value->o = taken;
 }
 
 /* Set the size of the STable. */
@@ -222,6 +409,20 @@ static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSeri
     st->size = sizeof(MVMConcBlockingQueue);
 }
 
+/* Serializes the REPR data. */
+static void serialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationWriter *writer) {
+    MVMConcBlockingQueueREPRData *repr_data = (MVMConcBlockingQueueREPRData *)st->REPR_data;
+    MVM_serialization_write_int(tc, writer, repr_data ? (MVMint64)repr_data->capacity : 0);
+}
+
+/* Deserializes the REPR data. */
+static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    MVMConcBlockingQueueREPRData *repr_data = MVM_calloc(1, sizeof(MVMConcBlockingQueueREPRData));
+    if (reader->root.version >= 21)
+        repr_data->capacity = (MVMuint64)MVM_serialization_read_int(tc, reader);
+    st->REPR_data = repr_data;
+}
+
 /* Initializes the representation. */
 const MVMREPROps * MVMConcBlockingQueue_initialize(MVMThreadContext *tc) {
     return &ConcBlockingQueue_this_repr;
@@ -257,14 +458,14 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
     NULL, /* change_type */
     NULL, /* serialize */
     NULL, /* deserialize */
-    NULL, /* serialize_repr_data */
-    NULL, /* deserialize_repr_data */
+    serialize_repr_data,
+    deserialize_repr_data,
     deserialize_stable_size,
     gc_mark,
     gc_free,
     NULL, /* gc_cleanup */
     NULL, /* gc_mark_repr_data */
-    NULL, /* gc_free_repr_data */
+    gc_free_repr_data,
     compose,
     NULL, /* spesh */
     "ConcBlockingQueue", /* name */
@@ -273,34 +474,17 @@ static const MVMREPROps ConcBlockingQueue_this_repr = {
     NULL, /* describe_refs */
 };
 
-/* Polls a queue for a value, returning NULL if none is available. */
+/* Polls a queue for a value, returning VMNull if none is available. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue) {
     MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)queue;
-    MVMConcBlockingQueueNode *taken;
-    MVMObject *result = tc->instance->VMNull;
-    unsigned int interval_id;
-
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll");
-    MVMROOT(tc, cbq, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->body.locks->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
-
-    if (MVM_load(&cbq->body.elems) > 0) {
-        taken = cbq->body.head->next;
-        MVM_free(cbq->body.head);
-        cbq->body.head = taken;
-        MVM_barrier();
-        result = taken->value;
-        taken->value = NULL;
-        MVM_barrier();
-        if (MVM_decr(&cbq->body.elems) > 1)
-            uv_cond_signal(&cbq->body.locks->head_cond);
+    MVMObject *result = try_take(tc, &(cbq->body));
+    if (!result)
+        return tc->instance->VMNull;
+    if (cbq->body.slots) {
+        MVMROOT(tc, result, {
+            wake_waiter(tc, cbq->body.locks, &(cbq->body.locks->push_waiters),
+                &(cbq->body.locks->not_full));
+        });
     }
-
-    uv_mutex_unlock(&cbq->body.locks->head_lock);
-
-    MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.poll");
     return result;
 }
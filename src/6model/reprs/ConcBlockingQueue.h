@@ -1,24 +1,56 @@
-/* A single node in the concurrent blocking queue. */
+/* The concurrent blocking queue comes in two flavors. By default, it is an
+ * unbounded lock-free linked list (the Michael-Scott queue); nodes come from
+ * the fixed size allocator and are given back at the next global safe point,
+ * which is what makes it safe for a thread to still be looking at a node that
+ * another thread just took off the queue. If a capacity is given at compose
+ * time, it is instead a lock-free ring buffer of that many slots, and pushes
+ * onto a full queue block until there is space, providing back-pressure.
+ *
+ * Threads that need to wait (for an item, or for space in a bounded queue)
+ * first spin for a short while, since hand-offs are often quick, and only
+ * then sleep on a condition variable. */
+
+/* A single node in an unbounded concurrent blocking queue. */
 struct MVMConcBlockingQueueNode {
     MVMObject                *value;
     MVMConcBlockingQueueNode *next;
 };
 
+/* A slot in a bounded concurrent blocking queue. The sequence number says
+ * whether the slot is ready to be pushed to or taken from for a position. */
+struct MVMConcBlockingQueueSlot {
+    AO_t       seq;
+    MVMObject *value;
+};
+
 /* Memory used for mutexes and cond vars; these can't live in the object body
  * directly as they are sensitive to being moved, but putting them together in
- * a single struct means we can malloc a single bit of memory to hold them. */
+ * a single struct means we can malloc a single bit of memory to hold them.
+ * They are only used by threads that need to sleep. */
 struct MVMConcBlockingQueueLocks {
-    uv_mutex_t  head_lock;
-    uv_mutex_t  tail_lock;
-    uv_cond_t   head_cond;
+    uv_mutex_t  lock;
+    uv_cond_t   not_empty;
+    uv_cond_t   not_full;
+
+    /* Number of threads sleeping (or about to) on each condition. */
+    AO_t        shift_waiters;
+    AO_t        push_waiters;
 };
 
 /* Representation used for concurrent blocking queue. */
 struct MVMConcBlockingQueueBody {
-    /* Head and tail of the queue. */
+    /* For an unbounded queue, head and tail of the list; the head is always
+     * a node whose value has already been taken. */
     MVMConcBlockingQueueNode *head;
     MVMConcBlockingQueueNode *tail;
 
+    /* For a bounded queue, the ring of slots, its size, and the positions
+     * the next push and take will use. slots is NULL if unbounded. */
+    MVMConcBlockingQueueSlot *slots;
+    MVMuint64                 capacity;
+    AO_t                      push_pos;
+    AO_t                      take_pos;
+
     /* Number of elements currently in the queue. */
     AO_t elems;
 
@@ -30,6 +62,15 @@ struct MVMConcBlockingQueue {
     MVMConcBlockingQueueBody body;
 };
 
+/* REPR data, saying if queues of this type are bounded. */
+struct MVMConcBlockingQueueREPRData {
+    /* The capacity, or 0 if unbounded. */
+    MVMuint64 capacity;
+};
+
+/* How many times to look for an item or space before going to sleep. */
+#define MVM_CBQ_SPIN_TRIES 128
+
 /* Function for REPR setup. */
 const MVMREPROps * MVMConcBlockingQueue_initialize(MVMThreadContext *tc);
 
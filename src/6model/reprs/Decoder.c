@@ -175,6 +175,17 @@ void MVM_decoder_set_separators(MVMThreadContext *tc, MVMDecoder *decoder, MVMOb
     }
 }
 
+/* Adds a buffer of bytes that was read from a handle to the decode stream,
+ * which takes ownership of it. If the pool size is non-zero, the buffer came
+ * from the I/O buffer pool and is given back there once decoded. */
+void MVM_decoder_add_pooled_bytes(MVMThreadContext *tc, MVMDecoder *decoder, char *buf,
+                                  MVMint64 length, size_t pool_size) {
+    MVMDecodeStream *ds = get_ds(tc, decoder);
+    enter_single_user(tc, decoder);
+    MVM_string_decodestream_add_pooled_bytes(tc, ds, buf, (MVMint32)length, pool_size);
+    exit_single_user(tc, decoder);
+}
+
 /* Adds bytes to the decode stream. */
 void MVM_decoder_add_bytes(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject *buffer) {
     MVMDecodeStream *ds = get_ds(tc, decoder);
@@ -265,6 +276,25 @@ MVMString * MVM_decoder_take_line(MVMThreadContext *tc, MVMDecoder *decoder,
     return result;
 }
 
+/* Takes all complete lines available in the decoder, pushing them onto the
+ * passed native string array, and returns how many there were. */
+MVMint64 MVM_decoder_take_lines(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject *result,
+                                MVMint64 chomp, MVMint64 incomplete_ok, MVMint64 share_blob) {
+    MVMDecodeStream *ds = get_ds(tc, decoder);
+    MVMDecodeStreamSeparators *sep_spec = get_sep_spec(tc, decoder);
+    MVMint64 taken = 0;
+    if (REPR(result)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(result) ||
+            ((MVMArrayREPRData *)STABLE(result)->REPR_data)->slot_type != MVM_ARRAY_STR)
+        MVM_exception_throw_adhoc(tc, "decodertakelines requires a native string array");
+    enter_single_user(tc, decoder);
+    MVMROOT(tc, decoder, {
+        taken = MVM_string_decodestream_get_lines(tc, ds, sep_spec, result,
+            (MVMint32)chomp, (MVMint32)incomplete_ok, (MVMint32)share_blob);
+    });
+    exit_single_user(tc, decoder);
+    return taken;
+}
+
 /* Returns true if the decoder is empty. */
 MVMint64 MVM_decoder_empty(MVMThreadContext *tc, MVMDecoder *decoder) {
     return MVM_string_decodestream_is_empty(tc, get_ds(tc, decoder));
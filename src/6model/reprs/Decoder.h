@@ -19,12 +19,16 @@ void MVM_decoder_configure(MVMThreadContext *tc, MVMDecoder *decoder,
 void MVM_decoder_set_separators(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject *sep_strings);
 MVMint64 MVM_decoder_empty(MVMThreadContext *tc, MVMDecoder *decoder);
 void MVM_decoder_add_bytes(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject *blob);
+void MVM_decoder_add_pooled_bytes(MVMThreadContext *tc, MVMDecoder *decoder, char *buf,
+                                  MVMint64 length, size_t pool_size);
 MVMString * MVM_decoder_take_all_chars(MVMThreadContext *tc, MVMDecoder *decoder);
 MVMString * MVM_decoder_take_available_chars(MVMThreadContext *tc, MVMDecoder *decoder);
 MVMString * MVM_decoder_take_chars(MVMThreadContext *tc, MVMDecoder *decoder, MVMint64 chars,
                                    MVMint64 eof);
 MVMString * MVM_decoder_take_line(MVMThreadContext *tc, MVMDecoder *decoder,
                                   MVMint64 chomp, MVMint64 incomplete_ok);
+MVMint64 MVM_decoder_take_lines(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject *result,
+                                MVMint64 chomp, MVMint64 incomplete_ok, MVMint64 share_blob);
 MVMint64 MVM_decoder_bytes_available(MVMThreadContext *tc, MVMDecoder *decoder);
 MVMObject * MVM_decoder_take_bytes(MVMThreadContext *tc, MVMDecoder *decoder,
                                    MVMObject *buf_type, MVMint64 bytes);
@@ -17,6 +17,9 @@ struct MVMAsyncTaskBody {
 
     /* The cancellation notification handler, if any. */
     MVMObject *cancel_notify_schedulee;
+
+    /* The event loop the task runs on; NULL until it is first queued. */
+    MVMEventLoop *event_loop;
 };
 struct MVMAsyncTask {
     MVMObject common;
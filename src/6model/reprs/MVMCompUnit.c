@@ -103,7 +103,12 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
         MVM_free(body->data_start);
         break;
     case MVM_DEALLOCATE_UNMAP:
-        MVM_platform_unmap_file(body->data_start, body->handle, body->data_size);
+        /* Strings made from the mapped string heap may well outlive us, so
+         * in that case the last of them unmaps it. */
+        if (body->mapping_id)
+            MVM_cu_release_mapping(tc, body->mapping_id);
+        else
+            MVM_platform_unmap_file(body->data_start, body->handle, body->data_size);
         break;
     default:
         MVM_panic(MVM_exitcode_NYI, "Invalid deallocate of %u during MVMCompUnit gc_free", body->deallocate);
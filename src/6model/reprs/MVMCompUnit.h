@@ -109,6 +109,24 @@ struct MVMCompUnitBody {
     /* How we should deallocate data_start. */
     MVMDeallocate deallocate;
 
+    /* Once we have made a string that uses its graphemes in place from the
+     * string heap in the mapped data, rather than a copy, the ID of the
+     * mapping, which is then shared with such strings; otherwise 0. */
+    MVMuint32 mapping_id;
+
+    /* Which frames an earlier run validated, if we loaded this from a
+     * bytecode file and a validation cache is in use; NULL otherwise. The
+     * instance owns it, so it outlives the compilation unit. */
+    MVMValidationCache *validation_cache;
+
+    /* If startup tracing, the phase for running the deserialize or load
+     * frame that is under way, and the phase validating frames is counted
+     * in (only used with the trace's mutex held, as threads may validate
+     * frames of the same compilation unit); 0 if none (that is the phase
+     * for creating the instance). */
+    MVMint32 startup_trace_run;
+    MVMint32 startup_trace_validate;
+
     /* List of serialization contexts in need of resolution. This is an
      * array of string handles; its length is determined by num_scs above.
      * once an SC has been resolved, the entry on this list is NULLed. If
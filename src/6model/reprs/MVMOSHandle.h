@@ -9,6 +9,10 @@ struct MVMOSHandleBody {
 
     /* Mutex protecting access to this I/O handle. */
     uv_mutex_t *mutex;
+
+    /* The event loop that async work on this handle is done on, if it has
+     * been bound to one. */
+    MVMEventLoop *event_loop;
 };
 struct MVMOSHandle {
     MVMObject common;
@@ -105,6 +105,7 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
         memcpy(dest_body->handlers, src_body->handlers,
             src_body->num_handlers * sizeof(MVMFrameHandler));
     dest_body->instrumentation_level = 0;
+    dest_body->frame_idx             = src_body->frame_idx;
     dest_body->num_annotations       = src_body->num_annotations;
     dest_body->annotations_data      = src_body->annotations_data;
     dest_body->fully_deserialized    = 1;
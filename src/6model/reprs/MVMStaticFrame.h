@@ -31,6 +31,10 @@ struct MVMStaticFrameBody {
      * the VM instance wide field for this. */
     MVMuint32 instrumentation_level;
 
+    /* The index of the frame in the frames of its compilation unit, as it
+     * was loaded. */
+    MVMuint32 frame_idx;
+
     /* Specialization-related information. Attached when a frame is first
      * verified. Held in a separate object rather than the MVMStaticFrame
      * itself partly to decrease the size of this object for frames that
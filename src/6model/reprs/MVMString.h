@@ -48,6 +48,11 @@ struct MVMStringBody {
     MVMuint16 num_strands;
     MVMuint32 num_graphs;
     MVMint32  cached_hash_code;
+
+    /* Non-zero if the storage is not ours to free, as it lives in a mapped
+     * bytecode file; this is then the ID of the mapping, which we hold a
+     * reference to (see MVMCompUnitMapping). */
+    MVMuint32 storage_mapping;
 };
 
 /* A strand of a string. */
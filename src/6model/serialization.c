@@ -4,13 +4,16 @@
 #ifndef MAX
     #define MAX(x, y) ((y) > (x) ? (y) : (x))
 #endif
+#ifndef MIN
+    #define MIN(x, y) ((x) < (y) ? (x) : (y))
+#endif
 
 /* Whether we deserialize lazily or not. */
 #define MVM_SERIALIZATION_LAZY 1
 
 /* Version of the serialization format that we are currently at and lowest
  * version we support. */
-#define CURRENT_VERSION 20
+#define CURRENT_VERSION 21
 #define MIN_VERSION     16
 
 /* Various sizes (in bytes). */
@@ -28,6 +31,7 @@
 #define OBJECT_SIZE_GUESS               8
 #define CLOSURES_TABLE_ENTRIES_GUESS    16
 #define CONTEXTS_TABLE_ENTRIES_GUESS    4
+#define SEEN_STRINGS_SIZE_GUESS         256
 #define DEFAULT_CONTEXTS_DATA_SIZE      1024
 #define DEFAULT_PARAM_INTERNS_DATA_SIZE 128
 
@@ -245,23 +249,68 @@ static void write_double(char *buffer, size_t offset, double value) {
 #endif
 }
 
+/* Gets the hash code of a string, computing it if it's not cached yet. */
+static MVMuint32 string_hash_code(MVMThreadContext *tc, MVMString *s) {
+    if (!s->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, s);
+    return (MVMuint32)s->body.cached_hash_code;
+}
+
+/* Finds the slot in the seen strings table for a string; either the one
+ * holding its string heap index, or the empty one where it should go. The
+ * table holds only indexes, so the GC never needs to know about it. */
+static MVMuint32 seen_string_slot(MVMThreadContext *tc, MVMSerializationWriter *writer, MVMString *s) {
+    MVMuint32 hash = string_hash_code(tc, s);
+    MVMuint32 mask = writer->seen_strings_size - 1;
+    MVMuint32 slot = hash & mask;
+    while (writer->seen_strings[slot]) {
+        MVMString *seen = MVM_repr_at_pos_s(tc, writer->root.string_heap,
+            writer->seen_strings[slot]);
+        if (seen == s || ((MVMuint32)seen->body.cached_hash_code == hash
+                && MVM_string_equal(tc, seen, s)))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/* Doubles the size of the seen strings table, putting the strings already
+ * in the string heap back into it. */
+static void grow_seen_strings(MVMThreadContext *tc, MVMSerializationWriter *writer) {
+    MVMuint32 num_strings = (MVMuint32)MVM_repr_elems(tc, writer->root.string_heap);
+    MVMuint32 i;
+    MVM_free(writer->seen_strings);
+    writer->seen_strings_size *= 2;
+    writer->seen_strings = MVM_calloc(writer->seen_strings_size, sizeof(MVMuint32));
+    for (i = 1; i < num_strings; i++) {
+        MVMString *s = MVM_repr_at_pos_s(tc, writer->root.string_heap, i);
+        writer->seen_strings[seen_string_slot(tc, writer, s)] = i;
+    }
+}
+
 /* Adds an item to the MVMString heap if needed, and returns the index where
  * it may be found. */
 static MVMint32 add_string_to_heap(MVMThreadContext *tc, MVMSerializationWriter *writer, MVMString *s) {
+    MVMuint32 slot;
+    MVMint64  next_idx;
     if (s == NULL) {
         /* We ensured that the first entry in the heap represents the null MVMString,
          * so can just hand back 0 here. */
         return 0;
     }
-    else if (MVM_repr_exists_key(tc, writer->seen_strings, s)) {
-        return (MVMint32)MVM_repr_at_key_int(tc, writer->seen_strings, s);
-    }
-    else {
-        MVMint64 next_idx = MVM_repr_elems(tc, writer->root.string_heap);
-        MVM_repr_bind_pos_s(tc, writer->root.string_heap, next_idx, s);
-        MVM_repr_bind_key_int(tc, writer->seen_strings, s, next_idx);
-        return (MVMint32)next_idx;
-    }
+    slot = seen_string_slot(tc, writer, s);
+    if (writer->seen_strings[slot])
+        return (MVMint32)writer->seen_strings[slot];
+
+    /* Not seen yet, so add it to the heap; keep the table at most half
+     * full, so that probe sequences stay short. */
+    next_idx = MVM_repr_elems(tc, writer->root.string_heap);
+    MVM_repr_bind_pos_s(tc, writer->root.string_heap, next_idx, s);
+    if ((MVMuint64)next_idx * 2 > writer->seen_strings_size)
+        grow_seen_strings(tc, writer);
+    else
+        writer->seen_strings[slot] = (MVMuint32)next_idx;
+    return (MVMint32)next_idx;
 }
 
 /* Gets the ID of a serialization context. Returns 0 if it's the current
@@ -788,6 +837,15 @@ void MVM_serialization_write_stable_ref(MVMThreadContext *tc, MVMSerializationWr
     write_locate_sc_and_index(tc, writer, sc_id, idx);
 }
 
+/* Copies a segment to its place in the output, and frees it, so that we
+ * never hold two copies of all of the serialized data at once. */
+static void append_segment(char *output, MVMuint32 *offset, char **segment, MVMuint32 size) {
+    memcpy(output + *offset, *segment, size);
+    MVM_free(*segment);
+    *segment = NULL;
+    *offset += MVM_ALIGN_SECTION(size);
+}
+
 /* Concatenates the various output segments into a single binary MVMString. */
 static MVMString * concatenate_outputs(MVMThreadContext *tc, MVMSerializationWriter *writer) {
     char      *output      = NULL;
@@ -819,69 +877,59 @@ static MVMString * concatenate_outputs(MVMThreadContext *tc, MVMSerializationWri
     /* Put dependencies table in place and set location/rows in header. */
     write_int32(output, 4, offset);
     write_int32(output, 8, writer->root.num_dependencies);
-    memcpy(output + offset, writer->root.dependencies_table,
+    append_segment(output, &offset, &writer->root.dependencies_table,
         writer->root.num_dependencies * DEP_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_dependencies * DEP_TABLE_ENTRY_SIZE);
 
     /* Put STables table in place, and set location/rows in header. */
     write_int32(output, 12, offset);
     write_int32(output, 16, writer->root.num_stables);
-    memcpy(output + offset, writer->root.stables_table,
+    append_segment(output, &offset, &writer->root.stables_table,
         writer->root.num_stables * STABLES_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_stables * STABLES_TABLE_ENTRY_SIZE);
 
     /* Put STables data in place. */
     write_int32(output, 20, offset);
-    memcpy(output + offset, writer->root.stables_data,
+    append_segment(output, &offset, &writer->root.stables_data,
         writer->stables_data_offset);
-    offset += MVM_ALIGN_SECTION(writer->stables_data_offset);
 
     /* Put objects table in place, and set location/rows in header. */
     write_int32(output, 24, offset);
     write_int32(output, 28, writer->root.num_objects);
-    memcpy(output + offset, writer->root.objects_table,
+    append_segment(output, &offset, &writer->root.objects_table,
         writer->root.num_objects * OBJECTS_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_objects * OBJECTS_TABLE_ENTRY_SIZE);
 
     /* Put objects data in place. */
     write_int32(output, 32, offset);
-    memcpy(output + offset, writer->root.objects_data,
+    append_segment(output, &offset, &writer->root.objects_data,
         writer->objects_data_offset);
-    offset += MVM_ALIGN_SECTION(writer->objects_data_offset);
 
     /* Put closures table in place, and set location/rows in header. */
     write_int32(output, 36, offset);
     write_int32(output, 40, writer->root.num_closures);
-    memcpy(output + offset, writer->root.closures_table,
+    append_segment(output, &offset, &writer->root.closures_table,
         writer->root.num_closures * CLOSURES_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_closures * CLOSURES_TABLE_ENTRY_SIZE);
 
     /* Put contexts table in place, and set location/rows in header. */
     write_int32(output, 44, offset);
     write_int32(output, 48, writer->root.num_contexts);
-    memcpy(output + offset, writer->root.contexts_table,
+    append_segment(output, &offset, &writer->root.contexts_table,
         writer->root.num_contexts * CONTEXTS_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_contexts * CONTEXTS_TABLE_ENTRY_SIZE);
 
     /* Put contexts data in place. */
     write_int32(output, 52, offset);
-    memcpy(output + offset, writer->root.contexts_data,
+    append_segment(output, &offset, &writer->root.contexts_data,
         writer->contexts_data_offset);
-    offset += MVM_ALIGN_SECTION(writer->contexts_data_offset);
 
     /* Put repossessions table in place, and set location/rows in header. */
     write_int32(output, 56, offset);
     write_int32(output, 60, writer->root.num_repos);
-    memcpy(output + offset, writer->root.repos_table,
+    append_segment(output, &offset, &writer->root.repos_table,
         writer->root.num_repos * REPOS_TABLE_ENTRY_SIZE);
-    offset += MVM_ALIGN_SECTION(writer->root.num_repos * REPOS_TABLE_ENTRY_SIZE);
 
     /* Put parameterized type intern data in place. */
     write_int32(output, 64, offset);
     write_int32(output, 68, writer->root.num_param_interns);
-    memcpy(output + offset, writer->root.param_interns_data,
+    append_segment(output, &offset, &writer->root.param_interns_data,
         writer->param_interns_data_offset);
-    offset += MVM_ALIGN_SECTION(writer->param_interns_data_offset);
 
     /* Sanity check. */
     if (offset != output_size)
@@ -1376,7 +1424,8 @@ MVMString * MVM_serialization_serialize(MVMThreadContext *tc, MVMSerializationCo
     writer->codes_list          = sc->body->root_codes;
     writer->root.string_heap    = empty_string_heap;
     writer->root.dependent_scs  = MVM_calloc(1, sizeof(MVMSerializationContext *));
-    writer->seen_strings        = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    writer->seen_strings_size   = SEEN_STRINGS_SIZE_GUESS;
+    writer->seen_strings        = MVM_calloc(writer->seen_strings_size, sizeof(MVMuint32));
 
     /* Allocate initial memory space for storing serialized tables and data. */
     writer->dependencies_table_alloc = DEP_TABLE_ENTRY_SIZE * 4;
@@ -1422,6 +1471,7 @@ MVMString * MVM_serialization_serialize(MVMThreadContext *tc, MVMSerializationCo
     MVM_free(writer->root.contexts_data);
     MVM_free(writer->root.param_interns_data);
     MVM_free(writer->root.repos_table);
+    MVM_free(writer->seen_strings);
     MVM_free(writer);
 
     /* Exit gen2 allocation. */
@@ -1554,7 +1604,12 @@ MVMint64 MVM_serialization_read_int64(MVMThreadContext *tc, MVMSerializationRead
  * The format chosen may not be quite the most space efficient for the values
  * that we store, but the intent it is that close to smallest whilst very
  * efficient to read. In particular, it doesn't require any looping, and
- * has at most two length overrun checks.  */
+ * has at most two length overrun checks.
+ *
+ * When there are at least 9 bytes left, no integer can overrun, so we do a
+ * single check up front and then read the value bytes with one fixed size
+ * load, rather than a memcpy of a variable number of bytes. Only the last
+ * few integers of a buffer take the fully checked path. */
 
 MVMint64 MVM_serialization_read_int(MVMThreadContext *tc, MVMSerializationReader *reader) {
     MVMint64 result;
@@ -1563,6 +1618,34 @@ MVMint64 MVM_serialization_read_int(MVMThreadContext *tc, MVMSerializationReader
     MVMuint8 first;
     MVMuint8 need;
 
+#ifndef MVM_BIGENDIAN
+    if (read_end - read_at >= 9) {
+        MVMuint64 word;
+        MVMuint32 bits;
+        first = *read_at;
+        if (first & 0x80) {
+            *(reader->cur_read_offset) += 1;
+            return (MVMint64)first - 129;
+        }
+        need = first >> 4;
+        if (!need) {
+            memcpy(&result, read_at + 1, 8);
+            *(reader->cur_read_offset) += 9;
+            return result;
+        }
+
+        /* The word has the first byte at the bottom, then the value bytes;
+         * put the low nybble of the first byte above those, and sign extend
+         * from there. */
+        memcpy(&word, read_at, 8);
+        bits   = 8 * need;
+        result = (MVMint64)(((word >> 8) & (((MVMuint64)1 << bits) - 1)) | ((MVMuint64)first << bits));
+        result = (MVMint64)((MVMuint64)result << (60 - bits)) >> (60 - bits);
+        *(reader->cur_read_offset) += need + 1;
+        return result;
+    }
+#endif
+
     if (read_at >= read_end)
         fail_deserialize(tc, reader,
                          "Read past end of serialization data buffer");
@@ -3033,18 +3116,248 @@ static void resolve_param_interns(MVMThreadContext *tc, MVMSerializationReader *
     }
 }
 
+/* Number of STables or objects a preload helper thread deserializes at a time
+ * before letting go of the SC's lock. */
+#define PRELOAD_CHUNK_SIZE 256
+
+/* Stubs the specified STables and objects of an SC that is being preloaded,
+ * and then deserializes them in a single run of the work loop, rather than
+ * one demand at a time as the program runs into them. */
+static void preload_some(MVMThreadContext *tc, MVMSerializationContext *sc,
+                         MVMuint32 *stables, MVMuint32 num_stables,
+                         MVMuint32 *objects, MVMuint32 num_objects) {
+    MVMSerializationReader *reader = sc->body->sr;
+    MVMuint32               i;
+    MVMROOT(tc, sc, {
+        MVM_reentrantmutex_lock(tc, (MVMReentrantMutex *)sc->body->mutex);
+    });
+    reader->working++;
+    MVM_gc_allocate_gen2_default_set(tc);
+    for (i = 0; i < num_stables; i++) {
+        MVMuint32 idx = stables[i];
+        if (!sc->body->root_stables[idx]) {
+            stub_stable(tc, reader, idx);
+            worklist_add_index(tc, &(reader->wl_stables), idx);
+        }
+    }
+    for (i = 0; i < num_objects; i++) {
+        MVMuint32 idx = objects[i];
+        if (!sc->body->root_objects[idx]) {
+            stub_object(tc, reader, idx);
+            worklist_add_index(tc, &(reader->wl_objects), idx);
+        }
+    }
+    if (reader->working == 1)
+        work_loop(tc, reader);
+    MVM_gc_allocate_gen2_default_clear(tc);
+    reader->working--;
+    MVM_reentrantmutex_unlock(tc, (MVMReentrantMutex *)sc->body->mutex);
+}
+
+/* Entry point of a preload helper thread. It takes SCs off the preload queue
+ * and deserializes their working sets a chunk at a time, releasing the SC's
+ * lock in between so a thread that needs something from the SC right away
+ * does not wait for the whole working set, and checking in with the GC. As
+ * the SCs an SC depends on are always loaded before it, and we only ever go
+ * on to take the lock of a dependency, helpers working on different SCs in
+ * parallel cannot deadlock with each other or with the loading thread. */
+static void preload_worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
+    while (1) {
+        MVMSerializationContext *sc = (MVMSerializationContext *)MVM_repr_shift_o(tc,
+            tc->instance->sc_preload_queue);
+        MVMROOT(tc, sc, {
+            MVMSerializationPreload *pl = sc->body->sr->preload;
+            unsigned int interval_id = MVM_telemetry_interval_start(tc, "preload SC working set");
+            MVMuint32 i;
+            for (i = 0; i < pl->stables_num; i += PRELOAD_CHUNK_SIZE) {
+                preload_some(tc, sc, pl->stables + i,
+                    MIN(PRELOAD_CHUNK_SIZE, pl->stables_num - i), NULL, 0);
+                GC_SYNC_POINT(tc);
+            }
+            for (i = 0; i < pl->objects_num; i += PRELOAD_CHUNK_SIZE) {
+                preload_some(tc, sc, NULL, 0, pl->objects + i,
+                    MIN(PRELOAD_CHUNK_SIZE, pl->objects_num - i));
+                GC_SYNC_POINT(tc);
+            }
+            MVM_telemetry_interval_stop(tc, interval_id, "preloaded SC working set");
+        });
+    }
+}
+
+/* Starts the preload helper threads. */
+static void preload_start_workers(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    i;
+    instance->sc_preload_queue = MVM_repr_alloc_init(tc, instance->boot_types.BOOTQueue);
+    for (i = 0; i < instance->sc_preload_threads; i++) {
+        MVMObject *entry_point = MVM_repr_alloc_init(tc, instance->boot_types.BOOTCCode);
+        ((MVMCFunction *)entry_point)->body.func = preload_worker;
+        MVM_thread_run(tc, MVM_thread_new(tc, entry_point, 1));
+    }
+}
+
+/* If an earlier run left us the working set of the SC we just loaded, gets
+ * it deserialized: by the helper threads if we have them, so that loading
+ * goes on in the meantime and the working sets of SCs that don't depend on
+ * each other are deserialized in parallel, or otherwise right away. The
+ * indexes are in ascending order, so we pass through the serialized data in
+ * order. */
+static void preload(MVMThreadContext *tc, MVMSerializationContext *sc,
+                    MVMSerializationReader *reader) {
+    MVMSerializationPreload *pl = NULL;
+    MVMuint32                i;
+    char                    *handle;
+
+    if (!tc->instance->num_sc_preloads || !sc->body->handle)
+        return;
+    handle = MVM_string_utf8_encode_C_string(tc, sc->body->handle);
+    for (i = 0; i < tc->instance->num_sc_preloads; i++) {
+        if (strcmp(tc->instance->sc_preloads[i].handle, handle) == 0) {
+            pl = &(tc->instance->sc_preloads[i]);
+            break;
+        }
+    }
+    MVM_free(handle);
+    if (!pl || pl->num_stables != (MVMuint32)reader->root.num_stables
+            || pl->num_objects != (MVMuint32)reader->root.num_objects)
+        return;
+
+    reader->preload = pl;
+    if (tc->instance->sc_preload_queue)
+        MVM_repr_push_o(tc, tc->instance->sc_preload_queue, (MVMObject *)sc);
+    else
+        preload_some(tc, sc, pl->stables, pl->stables_num, pl->objects, pl->objects_num);
+}
+
+/* Reads the file holding the working set of an earlier run, if there is one
+ * yet, and remembers where to save the working set of this run. The file has
+ * a line "sc <num_stables> <num_objects> <handle>" for each SC, followed by
+ * lines "s <index>" and "o <index>" for the STables and objects needed. If we
+ * got a working set and are to preload it on helper threads, starts them. */
+void MVM_serialization_preload_init(MVMThreadContext *tc, const char *filename) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    alloc    = 0;
+    MVMint64     cur      = -1;
+    char         line[1024];
+    FILE        *fh;
+
+    instance->sc_preload_file = MVM_malloc(strlen(filename) + 1);
+    strcpy(instance->sc_preload_file, filename);
+    fh = fopen(filename, "r");
+    if (!fh)
+        return;
+    while (fgets(line, sizeof(line), fh)) {
+        size_t        len = strlen(line);
+        unsigned long num_stables, num_objects, idx;
+        int           handle_pos;
+        if (len && line[len - 1] == '\n')
+            line[--len] = '\0';
+        if (strncmp(line, "sc ", 3) == 0) {
+            MVMSerializationPreload *pl;
+            if (sscanf(line + 3, "%lu %lu %n", &num_stables, &num_objects, &handle_pos) < 2
+                    || !line[3 + handle_pos]) {
+                cur = -1;
+                continue;
+            }
+            if (instance->num_sc_preloads == alloc) {
+                alloc = alloc ? alloc * 2 : 16;
+                instance->sc_preloads = MVM_realloc(instance->sc_preloads,
+                    alloc * sizeof(MVMSerializationPreload));
+            }
+            cur = instance->num_sc_preloads++;
+            pl  = &(instance->sc_preloads[cur]);
+            memset(pl, 0, sizeof(MVMSerializationPreload));
+            pl->handle      = MVM_malloc(strlen(line + 3 + handle_pos) + 1);
+            strcpy(pl->handle, line + 3 + handle_pos);
+            pl->num_stables = (MVMuint32)num_stables;
+            pl->num_objects = (MVMuint32)num_objects;
+        }
+        else if (cur >= 0 && (line[0] == 's' || line[0] == 'o') && line[1] == ' ') {
+            MVMSerializationPreload *pl = &(instance->sc_preloads[cur]);
+            idx = strtoul(line + 2, NULL, 10);
+            if (line[0] == 's' && idx < pl->num_stables)
+                MVM_VECTOR_PUSH(pl->stables, (MVMuint32)idx);
+            else if (line[0] == 'o' && idx < pl->num_objects)
+                MVM_VECTOR_PUSH(pl->objects, (MVMuint32)idx);
+        }
+    }
+    fclose(fh);
+    if (instance->num_sc_preloads && instance->sc_preload_threads)
+        preload_start_workers(tc);
+}
+
+/* Saves the STables and objects of each SC that were deserialized in this
+ * run, so the next run can preload them. */
+void MVM_serialization_preload_save(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    i, j;
+    FILE        *fh;
+    if (!instance->sc_preload_file)
+        return;
+    fh = fopen(instance->sc_preload_file, "w");
+    if (!fh)
+        return;
+    uv_mutex_lock(&instance->mutex_sc_weakhash);
+    for (i = 1; i < instance->all_scs_next_idx; i++) {
+        MVMSerializationContextBody *scb = instance->all_scs[i];
+        MVMSerializationReader      *sr  = scb ? scb->sr : NULL;
+        char                        *handle;
+        if (!sr || !scb->handle)
+            continue;
+        handle = MVM_string_utf8_encode_C_string(tc, scb->handle);
+        fprintf(fh, "sc %"PRId32" %"PRId32" %s\n", sr->root.num_stables,
+            sr->root.num_objects, handle);
+        MVM_free(handle);
+        for (j = 0; j < (MVMuint32)sr->root.num_stables; j++)
+            if (scb->root_stables[j])
+                fprintf(fh, "s %"PRIu32"\n", j);
+        for (j = 0; j < (MVMuint32)sr->root.num_objects; j++)
+            if (scb->root_objects[j])
+                fprintf(fh, "o %"PRIu32"\n", j);
+    }
+    uv_mutex_unlock(&instance->mutex_sc_weakhash);
+    fclose(fh);
+
+    /* Only save once, even if we pass through more than one exit path. */
+    MVM_free(instance->sc_preload_file);
+    instance->sc_preload_file = NULL;
+}
+
+/* Frees the working set read at startup. */
+void MVM_serialization_preload_destroy(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    i;
+    for (i = 0; i < instance->num_sc_preloads; i++) {
+        MVM_free(instance->sc_preloads[i].handle);
+        MVM_VECTOR_DESTROY(instance->sc_preloads[i].stables);
+        MVM_VECTOR_DESTROY(instance->sc_preloads[i].objects);
+    }
+    MVM_free(instance->sc_preloads);
+    instance->sc_preloads     = NULL;
+    instance->num_sc_preloads = 0;
+    MVM_free(instance->sc_preload_file);
+    instance->sc_preload_file = NULL;
+}
+
 /* Takes serialized data, an empty SerializationContext to deserialize it into,
  * a strings heap and the set of static code refs for the compilation unit.
  * Deserializes the data into the required objects and STables. */
 void MVM_serialization_deserialize(MVMThreadContext *tc, MVMSerializationContext *sc,
         MVMObject *string_heap, MVMObject *codes_static,
         MVMObject *repo_conflicts, MVMString *data) {
-    MVMint32 scodes, i;
+    MVMint32 scodes, i, trace_phase;
 
     /* Allocate and set up reader. */
     MVMSerializationReader *reader = MVM_calloc(1, sizeof(MVMSerializationReader));
     reader->root.sc          = sc;
 
+    /* If tracing startup, the SC's handle is the subject. */
+    trace_phase = tc->instance->startup_trace
+        ? MVM_startup_trace_start(tc, "deserialize SC", sc->body->handle
+            ? MVM_string_utf8_c8_encode_C_string(tc, sc->body->handle)
+            : NULL)
+        : 0;
+
     /* If we've been given a NULL string heap, use that of the current
      * compilation unit. */
     if (MVM_is_null(tc, string_heap))
@@ -3127,6 +3440,9 @@ void MVM_serialization_deserialize(MVMThreadContext *tc, MVMSerializationContext
         (*tc->interp_cu)->body.serialized_size = 0;
     }
 
+    /* Deserialize what an earlier run needed up front. */
+    preload(tc, sc, reader);
+
     /* If lazy deserialization is disabled, deserialize everything. */
 #if !MVM_SERIALIZATION_LAZY
     for (i = 0; i < sc->body->num_objects; i++)
@@ -3137,6 +3453,8 @@ void MVM_serialization_deserialize(MVMThreadContext *tc, MVMSerializationContext
 
     /* Restore normal GC allocation. */
     MVM_gc_allocate_gen2_default_clear(tc);
+
+    MVM_startup_trace_stop(tc, trace_phase);
 }
 
 /*
@@ -67,6 +67,17 @@ struct MVMDeserializeWorklist {
     MVMuint32  alloc_indexes;
 };
 
+/* The STables and objects of a serialization context that were needed by an
+ * earlier run. The number of STables and objects the SC had then is kept too,
+ * so we can ignore the list if the SC has since changed. */
+struct MVMSerializationPreload {
+    char      *handle;
+    MVMuint32  num_stables;
+    MVMuint32  num_objects;
+    MVM_VECTOR_DECL(MVMuint32, stables);
+    MVM_VECTOR_DECL(MVMuint32, objects);
+};
+
 /* Represents the serialization reader and the various functions available
  * on it. */
 struct MVMSerializationReader {
@@ -118,6 +129,9 @@ struct MVMSerializationReader {
      * indicates when it should be. */
     char      *data;
     MVMuint32  data_needs_free;
+
+    /* The working set of an earlier run that is being preloaded, if any. */
+    MVMSerializationPreload *preload;
 };
 
 /* Represents the serialization writer and the various functions available
@@ -139,9 +153,12 @@ struct MVMSerializationWriter {
     MVMint64 objects_list_pos;
     MVMint64 contexts_list_pos;
 
-    /* Hash of strings we've already seen while serializing to the index they
-     * are placed at in the string heap. */
-    MVMObject *seen_strings;
+    /* Open addressing hash table of the strings we've already seen while
+     * serializing, keyed on their hash codes, holding the index they are
+     * placed at in the string heap (0, the null string, marks a free slot).
+     * Its size is a power of 2. */
+    MVMuint32 *seen_strings;
+    MVMuint32  seen_strings_size;
 
     /* Amount of memory allocated for various things. */
     MVMuint32 dependencies_table_alloc;
@@ -185,6 +202,11 @@ MVMSTable * MVM_serialization_demand_stable(MVMThreadContext *tc, MVMSerializati
 MVMObject * MVM_serialization_demand_code(MVMThreadContext *tc, MVMSerializationContext *sc, MVMint64 idx);
 void MVM_serialization_finish_deserialize_method_cache(MVMThreadContext *tc, MVMSTable *st);
 
+/* Working set preloading. */
+void MVM_serialization_preload_init(MVMThreadContext *tc, const char *filename);
+void MVM_serialization_preload_save(MVMThreadContext *tc);
+void MVM_serialization_preload_destroy(MVMThreadContext *tc);
+
 /* Reader/writer functions. */
 MVMint64 MVM_serialization_read_int64(MVMThreadContext *tc, MVMSerializationReader *reader);
 MVMint64 MVM_serialization_read_int(MVMThreadContext *tc, MVMSerializationReader *reader);
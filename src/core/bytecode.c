@@ -471,6 +471,7 @@ static MVMStaticFrame ** deserialize_frames(MVMThreadContext *tc, MVMCompUnit *c
         static_frame = (MVMStaticFrame *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTStaticFrame);
         MVM_ASSIGN_REF(tc, &(cu->common.header), frames[i], static_frame);
         static_frame_body = &static_frame->body;
+        static_frame_body->frame_idx = i;
         bytecode_pos = read_int32(pos, 0);
         bytecode_size = read_int32(pos, 4);
         if (bytecode_pos >= rs->bytecode_size) {
@@ -807,14 +808,14 @@ static MVMCallsite ** deserialize_callsites(MVMThreadContext *tc, MVMCompUnit *c
          * in the end we probably should calculate it by frame.) */
         if (callsites[i]->arg_count > cu_body->max_callsite_size)
             cu_body->max_callsite_size = callsites[i]->arg_count;
-
-        /* Try to intern the callsite (that is, see if it matches one the
-         * VM already knows about). If it does, it will free the memory
-         * associated and replace it with the interned one. Otherwise it
-         * will store this one, provided it meets the interning rules. */
-        MVM_callsite_try_intern(tc, &(callsites[i]));
     }
 
+    /* Try to intern the callsites (that is, see if they match ones the VM
+     * already knows about). Those that do have their memory freed and are
+     * replaced with the interned ones. The rest are stored, provided they
+     * meet the interning rules. */
+    MVM_callsite_try_intern_all(tc, callsites, rs->expected_callsites);
+
     /* Add one on to the maximum, to allow space for unshifting an extra
      * arg in the "supply invoked code object" case. */
     cu_body->max_callsite_size++;
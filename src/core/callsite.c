@@ -159,60 +159,163 @@ void MVM_callsite_initialize_common(MVMThreadContext *tc) {
     MVM_callsite_try_intern(tc, &ptr);
 }
 
-/* Tries to intern the callsite, freeing and updating the one passed in and
- * replacing it with an already interned one if we find it. */
-MVM_PUBLIC void MVM_callsite_try_intern(MVMThreadContext *tc, MVMCallsite **cs_ptr) {
-    MVMCallsiteInterns *interns    = tc->instance->callsite_interns;
-    MVMCallsite        *cs         = *cs_ptr;
-    MVMint32            num_flags  = cs->flag_count;
-    MVMint32            num_nameds = MVM_callsite_num_nameds(tc, cs);
-    MVMint32 i, found;
-
+/* Checks if a callsite is one we can intern; if so, sets the number of its
+ * non-flattening nameds. */
+static MVMint32 can_intern(MVMThreadContext *tc, MVMCallsite *cs, MVMint32 *num_nameds) {
     /* Can't intern anything with flattening. */
     if (cs->has_flattening)
-        return;
+        return 0;
 
     /* Also can't intern past the max arity. */
-    if (num_flags >= MVM_INTERN_ARITY_LIMIT)
-        return;
+    if (cs->flag_count >= MVM_INTERN_ARITY_LIMIT)
+        return 0;
 
     /* Can intern things with nameds, provided we know the names. */
-    if (num_nameds > 0 && !cs->arg_names)
-        return;
+    *num_nameds = MVM_callsite_num_nameds(tc, cs);
+    if (*num_nameds > 0 && !cs->arg_names)
+        return 0;
 
-    /* Obtain mutex protecting interns store. */
-    uv_mutex_lock(&tc->instance->mutex_callsite_interns);
+    return 1;
+}
+
+/* Searches the interned callsites of the callsite's arity for a match,
+ * starting from the specified index. This needs no lock: interned callsites
+ * are never changed or removed, a new one is in place before the count is
+ * increased to include it, and an array that is outgrown is only freed at
+ * the next safepoint. Returns the match or NULL, and updates the index to
+ * say how far we searched. */
+static MVMCallsite * find_interned(MVMThreadContext *tc, MVMCallsite *cs,
+                                   MVMint32 num_nameds, MVMuint32 *from) {
+    MVMCallsiteInterns  *interns   = tc->instance->callsite_interns;
+    MVMint32             num_flags = cs->flag_count;
+    MVMuint32            num       = (MVMuint32)MVM_load(&interns->num_by_arity[num_flags]);
+    MVMCallsite        **by_arity  = interns->by_arity[num_flags];
+    MVMuint32            i;
+    for (i = *from; i < num; i++)
+        if (callsites_equal(tc, by_arity[i], cs, num_flags, num_nameds))
+            return by_arity[i];
+    *from = num;
+    return NULL;
+}
 
-    /* Search for a match. */
-    found = 0;
-    for (i = 0; i < interns->num_by_arity[num_flags]; i++) {
-        if (callsites_equal(tc, interns->by_arity[num_flags][i], cs, num_flags, num_nameds)) {
-            /* Got a match! Free the one we were passed and replace it with
-             * the interned one. */
-            if (num_flags)
-                MVM_free(cs->arg_flags);
-            MVM_free(cs->arg_names);
-            MVM_free(cs);
-            *cs_ptr = interns->by_arity[num_flags][i];
-            found = 1;
-            break;
+/* Adds a callsite to the interned callsites. Must be called with the interns
+ * mutex held, so we're the only writer. */
+static void add_interned(MVMThreadContext *tc, MVMCallsite *cs) {
+    MVMCallsiteInterns *interns   = tc->instance->callsite_interns;
+    MVMint32            num_flags = cs->flag_count;
+    MVMuint32           num       = (MVMuint32)MVM_load(&interns->num_by_arity[num_flags]);
+
+    /* Grow the array if needed, copying it so that any thread searching the
+     * current one can go on doing so. */
+    if (num == interns->alloc_by_arity[num_flags]) {
+        MVMuint32     new_alloc = num ? num * 2 : 8;
+        MVMCallsite **new_array = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+            new_alloc * sizeof(MVMCallsite *));
+        if (num) {
+            memcpy(new_array, interns->by_arity[num_flags], num * sizeof(MVMCallsite *));
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                num * sizeof(MVMCallsite *), interns->by_arity[num_flags]);
         }
+        MVM_barrier();
+        interns->by_arity[num_flags]       = new_array;
+        interns->alloc_by_arity[num_flags] = new_alloc;
     }
 
-    /* If it wasn't found, store it for the future. */
+    /* Store it, then make it visible. */
+    cs->is_interned = 1;
+    interns->by_arity[num_flags][num] = cs;
+    MVM_store(&interns->num_by_arity[num_flags], num + 1);
+}
+
+/* Frees a callsite we found an interned match for. */
+static void free_duplicate(MVMCallsite *cs) {
+    if (cs->flag_count)
+        MVM_free(cs->arg_flags);
+    MVM_free(cs->arg_names);
+    MVM_free(cs);
+}
+
+/* Tries to intern the callsite, freeing and updating the one passed in and
+ * replacing it with an already interned one if we find it. Only if there is
+ * no match do we take the mutex, to add it. */
+MVM_PUBLIC void MVM_callsite_try_intern(MVMThreadContext *tc, MVMCallsite **cs_ptr) {
+    MVMCallsite *cs   = *cs_ptr;
+    MVMuint32    from = 0;
+    MVMint32     num_nameds;
+    MVMCallsite *found;
+
+    if (!can_intern(tc, cs, &num_nameds))
+        return;
+
+    /* Search for a match. If there is none, another thread may have added
+     * one since we looked, so search what it added under the mutex. */
+    found = find_interned(tc, cs, num_nameds, &from);
     if (!found) {
-        if (interns->num_by_arity[num_flags] % 8 == 0) {
-            if (interns->num_by_arity[num_flags])
-                interns->by_arity[num_flags] = MVM_realloc(
-                    interns->by_arity[num_flags],
-                    sizeof(MVMCallsite *) * (interns->num_by_arity[num_flags] + 8));
-            else
-                interns->by_arity[num_flags] = MVM_malloc(sizeof(MVMCallsite *) * 8);
+        uv_mutex_lock(&tc->instance->mutex_callsite_interns);
+        found = find_interned(tc, cs, num_nameds, &from);
+        if (!found)
+            add_interned(tc, cs);
+        uv_mutex_unlock(&tc->instance->mutex_callsite_interns);
+    }
+
+    /* If we got a match, free the one we were passed and replace it with the
+     * interned one. */
+    if (found) {
+        free_duplicate(cs);
+        *cs_ptr = found;
+    }
+}
+
+/* Tries to intern each of a list of callsites, such as those of a compilation
+ * unit being loaded, as MVM_callsite_try_intern would. We search for all of
+ * them first, and then take the mutex just once to add those that had no
+ * match. */
+void MVM_callsite_try_intern_all(MVMThreadContext *tc, MVMCallsite **callsites, MVMuint32 num_callsites) {
+    MVMuint32 *from    = NULL;
+    MVMuint32  missing = 0;
+    MVMuint32  i;
+
+    for (i = 0; i < num_callsites; i++) {
+        MVMuint32    searched = 0;
+        MVMint32     num_nameds;
+        MVMCallsite *found;
+        if (!can_intern(tc, callsites[i], &num_nameds))
+            continue;
+        found = find_interned(tc, callsites[i], num_nameds, &searched);
+        if (found) {
+            free_duplicate(callsites[i]);
+            callsites[i] = found;
+        }
+        else {
+            /* Note how far we searched, so we needn't search it again. */
+            if (!from)
+                from = MVM_calloc(num_callsites, sizeof(MVMuint32));
+            from[i] = searched;
+            missing++;
         }
-        interns->by_arity[num_flags][interns->num_by_arity[num_flags]++] = cs;
-        cs->is_interned = 1;
     }
+    if (!missing)
+        return;
 
-    /* Finally, release mutex. */
+    /* Add those we found no match for; the list may hold the same callsite
+     * twice, or another thread may have added it meanwhile, so search again
+     * from where we got to. */
+    uv_mutex_lock(&tc->instance->mutex_callsite_interns);
+    for (i = 0; i < num_callsites && missing; i++) {
+        MVMint32     num_nameds;
+        MVMCallsite *found;
+        if (callsites[i]->is_interned || !can_intern(tc, callsites[i], &num_nameds))
+            continue;
+        found = find_interned(tc, callsites[i], num_nameds, &from[i]);
+        if (found) {
+            free_duplicate(callsites[i]);
+            callsites[i] = found;
+        }
+        else {
+            add_interned(tc, callsites[i]);
+        }
+        missing--;
+    }
     uv_mutex_unlock(&tc->instance->mutex_callsite_interns);
+    MVM_free(from);
 }
@@ -105,13 +105,18 @@ struct MVMCallsite {
 /* Maximum arity + 1 that we'll intern callsites by. */
 #define MVM_INTERN_ARITY_LIMIT 8
 
-/* Interned callsites data structure. */
+/* Interned callsites data structure. Lookups are done without a lock; only
+ * additions take the interns mutex. */
 struct MVMCallsiteInterns {
-    /* Array of callsites, by arity. */
+    /* Array of callsites, by arity. These are allocated with the FSA, and an
+     * outgrown one is freed at the next safepoint. */
     MVMCallsite **by_arity[MVM_INTERN_ARITY_LIMIT];
 
     /* Number of callsites we have interned by arity. */
-    MVMint32 num_by_arity[MVM_INTERN_ARITY_LIMIT];
+    AO_t num_by_arity[MVM_INTERN_ARITY_LIMIT];
+
+    /* Number of callsites there is space for in each array. */
+    MVMuint32 alloc_by_arity[MVM_INTERN_ARITY_LIMIT];
 };
 
 /* Initialize the "common" callsites */
@@ -126,8 +131,9 @@ void MVM_callsite_destroy(MVMCallsite *cs);
 
 MVMCallsite *MVM_callsite_copy(MVMThreadContext *tc, const MVMCallsite *cs);
 
-/* Callsite interning function. */
+/* Callsite interning functions. */
 MVM_PUBLIC void MVM_callsite_try_intern(MVMThreadContext *tc, MVMCallsite **cs);
+void MVM_callsite_try_intern_all(MVMThreadContext *tc, MVMCallsite **callsites, MVMuint32 num_callsites);
 
 /* Count the number of nameds (excluding flattening). */
 MVM_STATIC_INLINE MVMuint16 MVM_callsite_num_nameds(MVMThreadContext *tc, const MVMCallsite *cs) {
@@ -19,7 +19,9 @@ MVMCompUnit * MVM_cu_from_bytes(MVMThreadContext *tc, MVMuint8 *bytes, MVMuint32
 
     /* Process the input. */
     MVMROOT(tc, cu, {
+        MVMint32 trace_phase = MVM_startup_trace_start(tc, "unpack bytecode", NULL);
         MVM_bytecode_unpack(tc, cu);
+        MVM_startup_trace_stop(tc, trace_phase);
     });
 
     /* Resolve HLL config. It may contain nursery pointers, so fire write
@@ -37,8 +39,15 @@ MVMCompUnit * MVM_cu_map_from_file(MVMThreadContext *tc, const char *filename) {
     void        *handle      = NULL;
     uv_file      fd;
     MVMuint64    size;
+    MVMint32     trace_phase = 0;
     uv_fs_t req;
 
+    if (tc->instance->startup_trace) {
+        char *subject = MVM_malloc(strlen(filename) + 1);
+        strcpy(subject, filename);
+        trace_phase = MVM_startup_trace_start(tc, "read bytecode file", subject);
+    }
+
     /* Ensure the file exists, and get its size. */
     if (uv_fs_stat(tc->loop, &req, filename, NULL) < 0) {
         MVM_exception_throw_adhoc(tc, "While looking for '%s': %s", filename, uv_strerror(req.result));
@@ -64,6 +73,8 @@ MVMCompUnit * MVM_cu_map_from_file(MVMThreadContext *tc, const char *filename) {
     cu = MVM_cu_from_bytes(tc, (MVMuint8 *)block, (MVMuint32)size);
     cu->body.handle = handle;
     cu->body.deallocate = MVM_DEALLOCATE_UNMAP;
+    MVM_validation_cache_load(tc, cu, (MVMuint8 *)block, size);
+    MVM_startup_trace_stop(tc, trace_phase);
     return cu;
 }
 
@@ -73,6 +84,7 @@ MVMCompUnit * MVM_cu_map_from_file_handle(MVMThreadContext *tc, uv_file fd, MVMu
     void        *block       = NULL;
     void        *handle      = NULL;
     MVMuint64    size;
+    MVMint32     trace_phase = MVM_startup_trace_start(tc, "read bytecode file handle", NULL);
     uv_fs_t req;
 
     /* Ensure the file exists, and get its size. */
@@ -93,6 +105,8 @@ MVMCompUnit * MVM_cu_map_from_file_handle(MVMThreadContext *tc, uv_file fd, MVMu
     cu = MVM_cu_from_bytes(tc, (MVMuint8 *)block, (MVMuint32)size);
     cu->body.handle = handle;
     cu->body.deallocate = MVM_DEALLOCATE_UNMAP;
+    MVM_validation_cache_load(tc, cu, (MVMuint8 *)block, size - pos);
+    MVM_startup_trace_stop(tc, trace_phase);
     return cu;
 }
 
@@ -200,6 +214,87 @@ static void compute_fast_table_upto(MVMThreadContext *tc, MVMCompUnit *cu, MVMui
     MVM_barrier();
     cu->body.string_heap_fast_table_top = end_bin;
 }
+/* Checks if a Latin-1 string heap entry is all ASCII. */
+static MVMint32 is_ascii(const MVMuint8 *bytes, MVMuint32 num_bytes) {
+    MVMuint32 i = 0;
+    for (; i + 8 <= num_bytes; i += 8) {
+        MVMuint64 word;
+        memcpy(&word, bytes + i, 8);
+        if (word & 0x8080808080808080ULL)
+            return 0;
+    }
+    for (; i < num_bytes; i++)
+        if (bytes[i] & 0x80)
+            return 0;
+    return 1;
+}
+
+/* Takes a reference to the mapping of a compilation unit's bytecode file for
+ * a string that will use bytes in it, putting the mapping in the instance's
+ * table (with a reference for the compilation unit too) the first time.
+ * Returns the mapping's ID. */
+static MVMuint32 hold_mapping(MVMThreadContext *tc, MVMCompUnit *cu) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    id;
+    uv_mutex_lock(&instance->mutex_cu_mappings);
+    id = cu->body.mapping_id;
+    if (!id) {
+        MVMCompUnitMapping *mapping = MVM_malloc(sizeof(MVMCompUnitMapping));
+        mapping->data   = cu->body.data_start;
+        mapping->handle = cu->body.handle;
+        mapping->size   = cu->body.data_size;
+        mapping->refs   = 1;
+        while (id < instance->num_cu_mappings && instance->cu_mappings[id])
+            id++;
+        if (id == instance->num_cu_mappings) {
+            instance->num_cu_mappings = instance->num_cu_mappings
+                ? 2 * instance->num_cu_mappings
+                : 8;
+            instance->cu_mappings = MVM_recalloc(instance->cu_mappings,
+                id * sizeof(MVMCompUnitMapping *),
+                instance->num_cu_mappings * sizeof(MVMCompUnitMapping *));
+        }
+        instance->cu_mappings[id] = mapping;
+        cu->body.mapping_id = ++id;
+    }
+    instance->cu_mappings[id - 1]->refs++;
+    uv_mutex_unlock(&instance->mutex_cu_mappings);
+    return id;
+}
+
+/* Drops a reference to the mapping of a bytecode file, unmapping it if that
+ * was the last one. Called when freeing a compilation unit or a string that
+ * used it, so maybe from several GC threads at once. */
+void MVM_cu_release_mapping(MVMThreadContext *tc, MVMuint32 mapping_id) {
+    MVMInstance        *instance = tc->instance;
+    MVMCompUnitMapping *mapping;
+    uv_mutex_lock(&instance->mutex_cu_mappings);
+    mapping = instance->cu_mappings[mapping_id - 1];
+    if (--mapping->refs == 0) {
+        instance->cu_mappings[mapping_id - 1] = NULL;
+        MVM_platform_unmap_file(mapping->data, mapping->handle, mapping->size);
+        MVM_free(mapping);
+    }
+    uv_mutex_unlock(&instance->mutex_cu_mappings);
+}
+
+/* Makes a string that uses an ASCII string heap entry in a mapped bytecode
+ * file as its graphemes in place. The MAST compiler only writes strings that
+ * are already in NFG and have no \r as Latin-1, so the bytes are just what
+ * 8-bit storage would hold. The pages of the file are shared by every process
+ * that maps it, rather than each having its own copy. The string holds the
+ * mapping until it is freed. */
+static MVMString * string_in_place(MVMThreadContext *tc, MVMCompUnit *cu,
+                                   MVMuint8 *bytes, MVMuint32 num_bytes) {
+    MVMString *s = (MVMString *)REPR(tc->instance->VMString)->allocate(tc,
+        STABLE(tc->instance->VMString));
+    s->body.storage_type    = MVM_STRING_GRAPHEME_8;
+    s->body.storage.blob_8  = (MVMGrapheme8 *)bytes;
+    s->body.num_graphs      = num_bytes;
+    s->body.storage_mapping = hold_mapping(tc, cu);
+    return s;
+}
+
 MVMString * MVM_cu_obtain_string(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint32 idx) {
     MVMuint32  cur_idx;
     MVMuint8  *cur_pos;
@@ -235,9 +330,12 @@ MVMString * MVM_cu_obtain_string(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint3
         if (cur_pos + bytes < limit) {
             MVMString *s;
             MVM_gc_allocate_gen2_default_set(tc);
-            s = decode_utf8
-                ? MVM_string_utf8_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes)
-                : MVM_string_latin1_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes);
+            if (decode_utf8)
+                s = MVM_string_utf8_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes);
+            else if (cu->body.deallocate == MVM_DEALLOCATE_UNMAP && is_ascii(cur_pos, bytes))
+                s = string_in_place(tc, cu, cur_pos, bytes);
+            else
+                s = MVM_string_latin1_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes);
             MVM_ASSIGN_REF(tc, &(cu->common.header), cu->body.strings[idx], s);
             MVM_gc_allocate_gen2_default_clear(tc);
             return s;
@@ -1,9 +1,22 @@
+/* The mapping of a bytecode file, once strings have been made that use bytes
+ * in it in place. The compilation unit holds a reference to it, as does each
+ * such string, since they may outlive it; it is unmapped when the last of
+ * them is freed. The instance keeps these in a table, and a string knows its
+ * mapping by its index in the table plus one. */
+struct MVMCompUnitMapping {
+    void      *data;
+    void      *handle;
+    MVMuint32  size;
+    MVMuint32  refs;
+};
+
 MVMCompUnit * MVM_cu_from_bytes(MVMThreadContext *tc, MVMuint8 *bytes, MVMuint32 size);
 MVMCompUnit * MVM_cu_map_from_file(MVMThreadContext *tc, const char *filename);
 MVMCompUnit * MVM_cu_map_from_file_handle(MVMThreadContext *tc, uv_file fd, MVMuint64 pos);
 MVMuint16 MVM_cu_callsite_add(MVMThreadContext *tc, MVMCompUnit *cu, MVMCallsite *cs);
 MVMuint32 MVM_cu_string_add(MVMThreadContext *tc, MVMCompUnit *cu, MVMString *str);
 MVMString * MVM_cu_obtain_string(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint32 idx);
+void MVM_cu_release_mapping(MVMThreadContext *tc, MVMuint32 mapping_id);
 
 MVM_STATIC_INLINE MVMString * MVM_cu_string(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint32 idx) {
     MVMString *s = cu->body.strings[idx];
@@ -46,8 +46,23 @@ static void prepare_and_verify_static_frame(MVMThreadContext *tc, MVMStaticFrame
         static_frame_body->work_size = sizeof(MVMRegister) *
             (static_frame_body->num_locals + static_frame_body->cu->body.max_callsite_size);
 
-        /* Validate the bytecode. */
-        MVM_validate_static_frame(tc, static_frame);
+        /* Validate the bytecode, unless an earlier run already did. */
+        if (!MVM_validation_cache_trusted(tc, static_frame)) {
+            unsigned int interval_id = MVM_telemetry_interval_start(tc, "validate static frame");
+            MVMint32     trace_phase = -1;
+            MVM_telemetry_interval_annotate((uintptr_t)cu, interval_id, "in this compunit");
+
+            /* If tracing startup, validating the frames of a compilation
+             * unit adds up to one phase. */
+            if (tc->instance->startup_trace)
+                trace_phase = MVM_startup_trace_enter(tc, &(cu->body.startup_trace_validate),
+                    "validate frames", MVM_startup_trace_cu_name(tc, cu));
+
+            MVM_validate_static_frame(tc, static_frame);
+            MVM_validation_cache_record(tc, static_frame);
+            MVM_startup_trace_stop(tc, trace_phase);
+            MVM_telemetry_interval_stop(tc, interval_id, "validate static frame");
+        }
 
         /* Compute work area initial state that we can memcpy into place each
          * time. */
@@ -132,10 +147,11 @@ static MVMFrame * create_context_only(MVMThreadContext *tc, MVMStaticFrame *stat
 
     MVMROOT(tc, static_frame, {
     MVMROOT(tc, code_ref, {
-        /* If the frame was never invoked before, need initial calculations
-         * and verification. */
-         if (static_frame->body.instrumentation_level == 0)
-             instrumentation_level_barrier(tc, static_frame);
+        /* A context-only frame never runs, so it only needs the lexical
+         * information of the static frame. Leave the initial calculations
+         * and verification until the static frame is really invoked. */
+        if (!static_frame->body.fully_deserialized)
+            MVM_bytecode_finish_frame(tc, static_frame->body.cu, static_frame, 0);
 
         frame = MVM_gc_allocate_frame(tc);
     });
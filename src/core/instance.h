@@ -84,6 +84,8 @@ struct MVMStringConsts {
     MVMString *translate_newlines;
     MVMString *platform_newline;
     MVMString *path;
+    MVMString *queue;
+    MVMString *capacity;
 };
 
 /* An entry in the representations registry. */
@@ -234,6 +236,26 @@ struct MVMInstance {
     MVMuint32                     all_scs_next_idx;
     MVMuint32                     all_scs_alloc;
 
+    /* STables and objects of each serialization context that an earlier run
+     * needed, which we deserialize up front when the SC is loaded, and the
+     * file the working set of this run is saved to at exit (NULL if not in
+     * use). */
+    MVMSerializationPreload      *sc_preloads;
+    MVMuint32                     num_sc_preloads;
+    char                         *sc_preload_file;
+
+    /* Number of helper threads to preload working sets on (0 to preload on
+     * the thread that loads the SC), and the queue of SCs for them. */
+    MVMuint32                     sc_preload_threads;
+    MVMObject                    *sc_preload_queue;
+
+    /* Directory to cache which frames of each bytecode file were validated
+     * in (NULL if not in use), and the cache entries of the bytecode files
+     * loaded so far, under a mutex. */
+    char                         *validation_cache_dir;
+    MVM_VECTOR_DECL(MVMValidationCache *, validation_caches);
+    uv_mutex_t                    mutex_validation_caches;
+
     /* Mutex to serialize additions of type parameterizations. Global rather
      * than per STable, as this doesn't happen often. */
     uv_mutex_t mutex_parameterization_add;
@@ -315,18 +337,19 @@ struct MVMInstance {
      * I/O and process state
      ************************************************************************/
 
-    /* The event loop thread, a mutex to avoid start-races, a concurrent
-     * queue of tasks that need to be processed by the event loop thread
-     * and an array of active tasks, for the purpose of keeping them GC
-     * marked. */
-    MVMThreadContext *event_loop_thread;
-    uv_mutex_t        mutex_event_loop_start;
-    uv_sem_t          sem_event_loop_started;
-    MVMObject        *event_loop_todo_queue;
-    MVMObject        *event_loop_permit_queue;
-    MVMObject        *event_loop_cancel_queue;
-    MVMObject        *event_loop_active;
-    uv_async_t       *event_loop_wakeup;
+    /* The event loops that async work is spread over, a mutex to avoid
+     * start-races, and a counter used to pick the loop for new work. Each
+     * loop has its own thread and queues of tasks; see MVMEventLoop. */
+    MVMEventLoop *event_loops;
+    MVMuint32     num_event_loops;
+    uv_mutex_t    mutex_event_loop_start;
+    AO_t          event_loop_next;
+
+    /* The io_uring that synchronous file handles use, made the first time
+     * one wants it, and set once we find the kernel won't give us one, so
+     * that we stop asking. */
+    MVMIOUring *io_uring;
+    AO_t        io_uring_unavailable;
 
     /* Standard file handles. */
     MVMObject *stdin_handle;
@@ -372,6 +395,17 @@ struct MVMInstance {
     MVMCallsiteInterns *callsite_interns;
     uv_mutex_t          mutex_callsite_interns;
 
+    /* Method dispatch tables, shared between STables with the same methods,
+     * in buckets by the hash of their method names. */
+    MVMMethodTable **method_tables;
+    uv_mutex_t       mutex_method_tables;
+
+    /* Mappings of bytecode files shared between compilation units and the
+     * strings using them in place, by ID less one; freed slots are NULL. */
+    MVMCompUnitMapping **cu_mappings;
+    MVMuint32            num_cu_mappings;
+    uv_mutex_t           mutex_cu_mappings;
+
     /* Normal Form Grapheme state (synthetics table, lookup, etc.). */
     MVMNFGState *nfg;
 
@@ -442,6 +476,12 @@ struct MVMInstance {
     MVMLoadedCompUnitName *loaded_compunits;
     uv_mutex_t       mutex_loaded_compunits;
 
+    /* Cache of MAST compiler output (NULL if not in use). */
+    MVMMASTCache    *mast_cache;
+
+    /* Startup tracing data (NULL if not in use). */
+    MVMStartupTrace *startup_trace;
+
     /* Hash of all loaded DLLs. */
     MVMDLLRegistry  *dll_registry;
     uv_mutex_t mutex_dll_registry;
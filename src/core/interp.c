@@ -2538,6 +2538,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 stable = STABLE(GET_REG(cur_op, 0).o);
                 MVM_ASSIGN_REF(tc, &(stable->header), stable->method_cache, cache);
                 stable->method_cache_sc = NULL;
+                stable->mode_flags |= MVM_METHOD_CACHE_PUBLISHED;
                 MVM_SC_WB_ST(tc, stable);
 
                 cur_op += 4;
@@ -3751,6 +3752,9 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             OP(exit): {
                 MVMint64 exit_code = GET_REG(cur_op, 0).i64;
                 MVM_io_flush_standard_handles(tc);
+                MVM_serialization_preload_save(tc);
+                MVM_validation_cache_save(tc);
+                MVM_startup_trace_write(tc);
                 exit(exit_code);
             }
             OP(cwd):
@@ -5271,6 +5275,42 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVM_nativecall_invoke_jit(tc, GET_REG(cur_op, 2).o);
                 cur_op += 6;
                 goto NEXT;
+            OP(decodertakelines): {
+                MVMObject *decoder = GET_REG(cur_op, 2).o;
+                MVM_decoder_ensure_decoder(tc, decoder, "decodertakelines");
+                GET_REG(cur_op, 0).i64 = MVM_decoder_take_lines(tc, (MVMDecoder *)decoder,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64,
+                    GET_REG(cur_op, 10).i64);
+                cur_op += 12;
+                goto NEXT;
+            }
+            OP(unicollkey):
+                GET_REG(cur_op, 0).o = MVM_unicode_string_collation_key_to_buf(tc,
+                    GET_REG(cur_op, 2).s, GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            OP(asyncwritebytesv):
+                GET_REG(cur_op, 0).o = MVM_io_write_bytes_vectored_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(decoderaddfh):
+                GET_REG(cur_op, 0).i64 = MVM_io_read_bytes_to_decoder(tc, GET_REG(cur_op, 4).o,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(sendfile):
+                GET_REG(cur_op, 0).i64 = MVM_io_send_file(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64);
+                cur_op += 10;
+                goto NEXT;
+            OP(asyncsendfile):
+                GET_REG(cur_op, 0).o = MVM_io_send_file_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).i64, GET_REG(cur_op, 12).i64, GET_REG(cur_op, 14).o);
+                cur_op += 16;
+                goto NEXT;
             OP(sp_guard): {
                 MVMObject *check = GET_REG(cur_op, 0).o;
                 MVMSTable *want  = (MVMSTable *)tc->cur_frame
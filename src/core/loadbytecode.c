@@ -10,6 +10,11 @@ static void mark_sr_data(MVMThreadContext *tc, MVMFrame *frame, MVMGCWorklist *w
 static void run_comp_unit(MVMThreadContext *tc, MVMCompUnit *cu) {
     /* If there's a deserialization frame, need to run that. */
     if (cu->body.deserialize_frame) {
+        /* If tracing startup, time it; run_load will stop the phase. */
+        if (tc->instance->startup_trace)
+            cu->body.startup_trace_run = MVM_startup_trace_start(tc,
+                "run deserialize frame", MVM_startup_trace_cu_name(tc, cu));
+
         /* Set up special return to delegate to running the load frame,
          * if any. */
         tc->cur_frame->return_value             = NULL;
@@ -100,17 +105,35 @@ void MVM_load_bytecode_fh(MVMThreadContext *tc, MVMObject *oshandle, MVMString *
     });
 }
 
+/* Callback after running the load code when tracing startup. */
+static void load_done(MVMThreadContext *tc, void *sr_data) {
+    MVMCompUnit *cu = (MVMCompUnit *)sr_data;
+    MVM_startup_trace_stop(tc, cu->body.startup_trace_run);
+    cu->body.startup_trace_run = 0;
+}
+
 /* Callback after running deserialize code to run the load code. */
 static void run_load(MVMThreadContext *tc, void *sr_data) {
     MVMCompUnit *cu = (MVMCompUnit *)sr_data;
 
+    /* If the deserialize code was traced, that's done. */
+    if (cu->body.startup_trace_run) {
+        MVM_startup_trace_stop(tc, cu->body.startup_trace_run);
+        cu->body.startup_trace_run = 0;
+    }
+
     /* If there's a load frame, need to run that. If not, we're done. */
     if (cu->body.load_frame) {
         /* Make sure the call happens in void context. No special return
-         * handler here; we want to go back to the place that used the
-         * loadbytecode op in the first place. */
+         * handler here unless we're tracing startup; we want to go back to
+         * the place that used the loadbytecode op in the first place. */
         tc->cur_frame->return_value = NULL;
         tc->cur_frame->return_type  = MVM_RETURN_VOID;
+        if (tc->instance->startup_trace) {
+            cu->body.startup_trace_run = MVM_startup_trace_start(tc,
+                "run load frame", MVM_startup_trace_cu_name(tc, cu));
+            MVM_frame_special_return(tc, tc->cur_frame, load_done, NULL, cu, mark_sr_data);
+        }
 
         /* Invoke the load frame and return to the runloop. */
         MVM_frame_invoke(tc, cu->body.load_frame, MVM_callsite_get_common(tc, MVM_CALLSITE_ID_NULL_ARGS),
@@ -784,6 +784,12 @@ static const void * const LABELS[] = {
     &&OP_nativeinvoke_n,
     &&OP_nativeinvoke_s,
     &&OP_nativeinvoke_o,
+    &&OP_decodertakelines,
+    &&OP_unicollkey,
+    &&OP_asyncwritebytesv,
+    &&OP_decoderaddfh,
+    &&OP_sendfile,
+    &&OP_asyncsendfile,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -1019,12 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
@@ -784,75 +784,81 @@
 #define MVM_OP_nativeinvoke_n 780
 #define MVM_OP_nativeinvoke_s 781
 #define MVM_OP_nativeinvoke_o 782
-#define MVM_OP_sp_guard 783
-#define MVM_OP_sp_guardconc 784
-#define MVM_OP_sp_guardtype 785
-#define MVM_OP_sp_guardsf 786
-#define MVM_OP_sp_guardsfouter 787
-#define MVM_OP_sp_rebless 788
-#define MVM_OP_sp_resolvecode 789
-#define MVM_OP_sp_decont 790
-#define MVM_OP_sp_getlex_o 791
-#define MVM_OP_sp_getlex_ins 792
-#define MVM_OP_sp_getlex_no 793
-#define MVM_OP_sp_getarg_o 794
-#define MVM_OP_sp_getarg_i 795
-#define MVM_OP_sp_getarg_n 796
-#define MVM_OP_sp_getarg_s 797
-#define MVM_OP_sp_fastinvoke_v 798
-#define MVM_OP_sp_fastinvoke_i 799
-#define MVM_OP_sp_fastinvoke_n 800
-#define MVM_OP_sp_fastinvoke_s 801
-#define MVM_OP_sp_fastinvoke_o 802
-#define MVM_OP_sp_paramnamesused 803
-#define MVM_OP_sp_getspeshslot 804
-#define MVM_OP_sp_findmeth 805
-#define MVM_OP_sp_fastcreate 806
-#define MVM_OP_sp_get_o 807
-#define MVM_OP_sp_get_i64 808
-#define MVM_OP_sp_get_i32 809
-#define MVM_OP_sp_get_i16 810
-#define MVM_OP_sp_get_i8 811
-#define MVM_OP_sp_get_n 812
-#define MVM_OP_sp_get_s 813
-#define MVM_OP_sp_bind_o 814
-#define MVM_OP_sp_bind_i64 815
-#define MVM_OP_sp_bind_i32 816
-#define MVM_OP_sp_bind_i16 817
-#define MVM_OP_sp_bind_i8 818
-#define MVM_OP_sp_bind_n 819
-#define MVM_OP_sp_bind_s 820
-#define MVM_OP_sp_p6oget_o 821
-#define MVM_OP_sp_p6ogetvt_o 822
-#define MVM_OP_sp_p6ogetvc_o 823
-#define MVM_OP_sp_p6oget_i 824
-#define MVM_OP_sp_p6oget_n 825
-#define MVM_OP_sp_p6oget_s 826
-#define MVM_OP_sp_p6obind_o 827
-#define MVM_OP_sp_p6obind_i 828
-#define MVM_OP_sp_p6obind_n 829
-#define MVM_OP_sp_p6obind_s 830
-#define MVM_OP_sp_deref_get_i64 831
-#define MVM_OP_sp_deref_get_n 832
-#define MVM_OP_sp_deref_bind_i64 833
-#define MVM_OP_sp_deref_bind_n 834
-#define MVM_OP_sp_getlexvia_o 835
-#define MVM_OP_sp_getlexvia_ins 836
-#define MVM_OP_sp_jit_enter 837
-#define MVM_OP_sp_boolify_iter 838
-#define MVM_OP_sp_boolify_iter_arr 839
-#define MVM_OP_sp_boolify_iter_hash 840
-#define MVM_OP_sp_cas_o 841
-#define MVM_OP_sp_atomicload_o 842
-#define MVM_OP_sp_atomicstore_o 843
-#define MVM_OP_prof_enter 844
-#define MVM_OP_prof_enterspesh 845
-#define MVM_OP_prof_enterinline 846
-#define MVM_OP_prof_enternative 847
-#define MVM_OP_prof_exit 848
-#define MVM_OP_prof_allocated 849
-#define MVM_OP_ctw_check 850
-#define MVM_OP_coverage_log 851
+#define MVM_OP_decodertakelines 783
+#define MVM_OP_unicollkey 784
+#define MVM_OP_asyncwritebytesv 785
+#define MVM_OP_decoderaddfh 786
+#define MVM_OP_sendfile 787
+#define MVM_OP_asyncsendfile 788
+#define MVM_OP_sp_guard 789
+#define MVM_OP_sp_guardconc 790
+#define MVM_OP_sp_guardtype 791
+#define MVM_OP_sp_guardsf 792
+#define MVM_OP_sp_guardsfouter 793
+#define MVM_OP_sp_rebless 794
+#define MVM_OP_sp_resolvecode 795
+#define MVM_OP_sp_decont 796
+#define MVM_OP_sp_getlex_o 797
+#define MVM_OP_sp_getlex_ins 798
+#define MVM_OP_sp_getlex_no 799
+#define MVM_OP_sp_getarg_o 800
+#define MVM_OP_sp_getarg_i 801
+#define MVM_OP_sp_getarg_n 802
+#define MVM_OP_sp_getarg_s 803
+#define MVM_OP_sp_fastinvoke_v 804
+#define MVM_OP_sp_fastinvoke_i 805
+#define MVM_OP_sp_fastinvoke_n 806
+#define MVM_OP_sp_fastinvoke_s 807
+#define MVM_OP_sp_fastinvoke_o 808
+#define MVM_OP_sp_paramnamesused 809
+#define MVM_OP_sp_getspeshslot 810
+#define MVM_OP_sp_findmeth 811
+#define MVM_OP_sp_fastcreate 812
+#define MVM_OP_sp_get_o 813
+#define MVM_OP_sp_get_i64 814
+#define MVM_OP_sp_get_i32 815
+#define MVM_OP_sp_get_i16 816
+#define MVM_OP_sp_get_i8 817
+#define MVM_OP_sp_get_n 818
+#define MVM_OP_sp_get_s 819
+#define MVM_OP_sp_bind_o 820
+#define MVM_OP_sp_bind_i64 821
+#define MVM_OP_sp_bind_i32 822
+#define MVM_OP_sp_bind_i16 823
+#define MVM_OP_sp_bind_i8 824
+#define MVM_OP_sp_bind_n 825
+#define MVM_OP_sp_bind_s 826
+#define MVM_OP_sp_p6oget_o 827
+#define MVM_OP_sp_p6ogetvt_o 828
+#define MVM_OP_sp_p6ogetvc_o 829
+#define MVM_OP_sp_p6oget_i 830
+#define MVM_OP_sp_p6oget_n 831
+#define MVM_OP_sp_p6oget_s 832
+#define MVM_OP_sp_p6obind_o 833
+#define MVM_OP_sp_p6obind_i 834
+#define MVM_OP_sp_p6obind_n 835
+#define MVM_OP_sp_p6obind_s 836
+#define MVM_OP_sp_deref_get_i64 837
+#define MVM_OP_sp_deref_get_n 838
+#define MVM_OP_sp_deref_bind_i64 839
+#define MVM_OP_sp_deref_bind_n 840
+#define MVM_OP_sp_getlexvia_o 841
+#define MVM_OP_sp_getlexvia_ins 842
+#define MVM_OP_sp_jit_enter 843
+#define MVM_OP_sp_boolify_iter 844
+#define MVM_OP_sp_boolify_iter_arr 845
+#define MVM_OP_sp_boolify_iter_hash 846
+#define MVM_OP_sp_cas_o 847
+#define MVM_OP_sp_atomicload_o 848
+#define MVM_OP_sp_atomicstore_o 849
+#define MVM_OP_prof_enter 850
+#define MVM_OP_prof_enterspesh 851
+#define MVM_OP_prof_enterinline 852
+#define MVM_OP_prof_enternative 853
+#define MVM_OP_prof_exit 854
+#define MVM_OP_prof_allocated 855
+#define MVM_OP_ctw_check 856
+#define MVM_OP_coverage_log 857
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
@@ -105,6 +105,15 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
     MVM_free(tc->nfa_longlit);
     MVM_free(tc->multi_dim_indices);
 
+    /* Free the synthetic grapheme lookup cache. */
+    MVM_free(tc->nfg_cache);
+
+    /* Free the collation sort key cache. */
+    MVM_unicode_collation_key_cache_destroy(tc);
+
+    /* Free the pool of I/O buffers. */
+    MVM_io_buffer_pool_destroy(tc);
+
     /* Destroy the libuv event loop */
     uv_loop_delete(tc->loop);
 
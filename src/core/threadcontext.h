@@ -78,6 +78,12 @@ struct MVMThreadContext {
     /* Number of bytes promoted to gen2 in current GC run. */
     MVMuint32 gc_promoted_bytes;
 
+    /* Bytes this thread allocated in the nursery before the current tospace
+     * was started on (not counting objects the GC copied there), and bytes
+     * it allocated directly in gen2. Used for startup tracing. */
+    MVMuint64 nursery_allocated_bytes;
+    MVMuint64 gen2_allocated_bytes;
+
     /* Temporarily rooted objects. This is generally used by code written in
      * C that wants to keep references to objects. Since those may change
      * if the code in question also allocates, there is a need to register
@@ -216,6 +222,9 @@ struct MVMThreadContext {
     /* libuv event loop */
     uv_loop_t *loop;
 
+    /* If this thread runs an event loop, the event loop it runs. */
+    MVMEventLoop *event_loop;
+
     /* Mutex that must be released if we throw an exception. Used in places
      * like I/O, which grab a mutex but may throw an exception. */
     uv_mutex_t *ex_release_mutex;
@@ -256,6 +265,15 @@ struct MVMThreadContext {
     MVMint64 *nfa_longlit;
     MVMint64  nfa_longlit_len;
 
+    /* Cache of recently seen synthetic graphemes; see nfg.c. */
+    MVMNFGThreadCache *nfg_cache;
+
+    /* Cache of recently computed collation sort keys; see unicode_ops.c. */
+    MVMCollationKeyCache *collation_key_cache;
+
+    /* Pool of free I/O read buffers; see bufferpool.c. */
+    MVMIOBufferPool *io_buffer_pool;
+
     /* Memory for doing multi-dim indexing with late-bound dimension counts. */
     MVMint64 *multi_dim_indices;
     MVMint64  num_multi_dim_indices;
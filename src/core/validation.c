@@ -719,3 +719,156 @@ void MVM_validate_static_frame(MVMThreadContext *tc,
     /* Validation successful. Clear up instruction offsets. */
     MVM_free(val->labels);
 }
+
+/* Hashes a bytecode file, seeded with the VM version, since what validation
+ * accepts may change between versions. This only needs to tell apart files
+ * that differ, so rather than a cryptographic hash it uses four independent
+ * lanes of multiply and xor-shift over 64-bit words, which is several times
+ * faster. */
+#define HASH_MUL 0x9E3779B97F4A7C15ULL
+static MVMuint64 hash_bytecode(const MVMuint8 *data, MVMuint64 size) {
+    const char *version = MVM_VERSION;
+    MVMuint64   lanes[4];
+    MVMuint64   seed = size;
+    MVMuint64   hash, i, j;
+    while (*version)
+        seed = (seed ^ (MVMuint8)*version++) * HASH_MUL;
+    for (j = 0; j < 4; j++)
+        lanes[j] = seed + j;
+    for (i = 0; i + 32 <= size; i += 32) {
+        for (j = 0; j < 4; j++) {
+            MVMuint64 word;
+            memcpy(&word, data + i + j * 8, 8);
+            lanes[j] = (lanes[j] ^ word) * HASH_MUL;
+            lanes[j] ^= lanes[j] >> 29;
+        }
+    }
+    for (; i < size; i++)
+        lanes[0] = (lanes[0] ^ data[i]) * HASH_MUL;
+    hash = seed;
+    for (j = 0; j < 4; j++) {
+        hash = (hash ^ lanes[j]) * HASH_MUL;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+/* Forms the name of the cache file for a bytecode file hash. */
+static char * cache_file_name(MVMThreadContext *tc, MVMuint64 hash) {
+    const char *dir  = tc->instance->validation_cache_dir;
+    size_t      len  = strlen(dir) + 24;
+    char       *name = MVM_malloc(len);
+    snprintf(name, len, "%s/%016"PRIx64".valid", dir, hash);
+    return name;
+}
+
+/* Sets up the validation cache, which will live in the given directory. */
+void MVM_validation_cache_init(MVMThreadContext *tc, const char *dir) {
+    MVMInstance *instance = tc->instance;
+    instance->validation_cache_dir = MVM_malloc(strlen(dir) + 1);
+    strcpy(instance->validation_cache_dir, dir);
+    MVM_VECTOR_INIT(instance->validation_caches, 16);
+    uv_mutex_init(&instance->mutex_validation_caches);
+}
+
+/* Called with the data of a compilation unit that was loaded from a bytecode
+ * file. Reads which of its frames were validated by an earlier run, if any.
+ * Validating a frame rewrites its bytecode on big endian platforms, so there
+ * we can never skip it, and don't bother with the cache. */
+void MVM_validation_cache_load(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint8 *data, MVMuint64 size) {
+#ifndef MVM_BIGENDIAN
+    MVMInstance        *instance = tc->instance;
+    MVMValidationCache *cache;
+    MVMuint32           bitmap_size;
+    char               *name;
+    FILE               *fh;
+    if (!instance->validation_cache_dir)
+        return;
+
+    cache             = MVM_calloc(1, sizeof(MVMValidationCache));
+    cache->hash       = hash_bytecode(data, size);
+    cache->num_frames = cu->body.orig_frames;
+    bitmap_size       = (cache->num_frames + 7) / 8;
+    cache->validated  = MVM_calloc(1, bitmap_size ? bitmap_size : 1);
+
+    /* The file holds the number of frames then the bitmap; if either doesn't
+     * match up, we ignore it. */
+    name = cache_file_name(tc, cache->hash);
+    fh   = fopen(name, "rb");
+    MVM_free(name);
+    if (fh) {
+        MVMuint32 num_frames;
+        if (fread(&num_frames, sizeof(MVMuint32), 1, fh) != 1
+                || num_frames != cache->num_frames
+                || fread(cache->validated, 1, bitmap_size, fh) != bitmap_size)
+            memset(cache->validated, 0, bitmap_size);
+        fclose(fh);
+    }
+
+    uv_mutex_lock(&instance->mutex_validation_caches);
+    MVM_VECTOR_PUSH(instance->validation_caches, cache);
+    uv_mutex_unlock(&instance->mutex_validation_caches);
+    cu->body.validation_cache = cache;
+#endif
+}
+
+/* Checks if a frame is known to pass validation. Called with the compilation
+ * unit's frame deserialization mutex held, as is recording a frame. */
+MVMint32 MVM_validation_cache_trusted(MVMThreadContext *tc, MVMStaticFrame *static_frame) {
+    MVMValidationCache *cache = static_frame->body.cu->body.validation_cache;
+    MVMuint32           idx   = static_frame->body.frame_idx;
+    return cache && idx < cache->num_frames && (cache->validated[idx / 8] & (1 << (idx % 8)));
+}
+
+/* Records that a frame passed validation. */
+void MVM_validation_cache_record(MVMThreadContext *tc, MVMStaticFrame *static_frame) {
+    MVMValidationCache *cache = static_frame->body.cu->body.validation_cache;
+    MVMuint32           idx   = static_frame->body.frame_idx;
+    if (cache && idx < cache->num_frames) {
+        cache->validated[idx / 8] |= 1 << (idx % 8);
+        cache->changed = 1;
+    }
+}
+
+/* Writes out the cache file of each bytecode file that had frames validated
+ * for the first time in this run. */
+void MVM_validation_cache_save(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    i;
+    if (!instance->validation_cache_dir)
+        return;
+    uv_mutex_lock(&instance->mutex_validation_caches);
+    for (i = 0; i < instance->validation_caches_num; i++) {
+        MVMValidationCache *cache = instance->validation_caches[i];
+        char               *name;
+        FILE               *fh;
+        if (!cache->changed)
+            continue;
+        name = cache_file_name(tc, cache->hash);
+        fh   = fopen(name, "wb");
+        MVM_free(name);
+        if (!fh)
+            continue;
+        fwrite(&cache->num_frames, sizeof(MVMuint32), 1, fh);
+        fwrite(cache->validated, 1, (cache->num_frames + 7) / 8, fh);
+        fclose(fh);
+        cache->changed = 0;
+    }
+    uv_mutex_unlock(&instance->mutex_validation_caches);
+}
+
+/* Frees the validation cache entries. */
+void MVM_validation_cache_destroy(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    i;
+    if (!instance->validation_cache_dir)
+        return;
+    for (i = 0; i < instance->validation_caches_num; i++) {
+        MVM_free(instance->validation_caches[i]->validated);
+        MVM_free(instance->validation_caches[i]);
+    }
+    MVM_VECTOR_DESTROY(instance->validation_caches);
+    uv_mutex_destroy(&instance->mutex_validation_caches);
+    MVM_free(instance->validation_cache_dir);
+    instance->validation_cache_dir = NULL;
+}
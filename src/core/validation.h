@@ -6,3 +6,24 @@ enum {
 };
 
 void MVM_validate_static_frame(MVMThreadContext *tc, MVMStaticFrame *static_frame);
+
+/* Which frames of a bytecode file have passed validation, in this run or an
+ * earlier one. Bytecode files are identified by a hash of their contents. */
+struct MVMValidationCache {
+    /* Hash of the bytecode file. */
+    MVMuint64 hash;
+
+    /* Number of frames in the file, and a bitmap of those validated. */
+    MVMuint32 num_frames;
+    MVMuint8 *validated;
+
+    /* Set when we validated a frame not in the cache file. */
+    MVMuint8 changed;
+};
+
+void MVM_validation_cache_init(MVMThreadContext *tc, const char *dir);
+void MVM_validation_cache_load(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint8 *data, MVMuint64 size);
+MVMint32 MVM_validation_cache_trusted(MVMThreadContext *tc, MVMStaticFrame *static_frame);
+void MVM_validation_cache_record(MVMThreadContext *tc, MVMStaticFrame *static_frame);
+void MVM_validation_cache_save(MVMThreadContext *tc);
+void MVM_validation_cache_destroy(MVMThreadContext *tc);
@@ -8,7 +8,9 @@ void MVM_gc_allocate_gen2_default_set(MVMThreadContext *tc);
 void MVM_gc_allocate_gen2_default_clear(MVMThreadContext *tc);
 
 MVM_STATIC_INLINE void * MVM_gc_allocate(MVMThreadContext *tc, size_t size) {
-    return tc->allocate_in_gen2
-        ? MVM_gc_gen2_allocate_zeroed(tc->gen2, size)
-        : MVM_gc_allocate_nursery(tc, size);
+    if (tc->allocate_in_gen2) {
+        tc->gen2_allocated_bytes += size;
+        return MVM_gc_gen2_allocate_zeroed(tc->gen2, size);
+    }
+    return MVM_gc_allocate_nursery(tc, size);
 }
@@ -53,6 +53,9 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
     /* Create a GC worklist. */
     MVMGCWorklist *worklist = MVM_gc_worklist_create(tc, gen != MVMGCGenerations_Nursery);
 
+    /* Where objects we copy into tospace start (moved if we flip). */
+    void *copy_start = tc->nursery_alloc;
+
     /* Initialize work passing data structure. */
     WorkToPass wtp;
     wtp.num_target_threads = 0;
@@ -102,8 +105,11 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
             tc->nursery_tospace = MVM_calloc(1, tc->nursery_tospace_size);
         }
 
-        /* Reset nursery allocation pointers to the new tospace. */
+        /* Count what was allocated in the old tospace, and reset nursery
+         * allocation pointers to the new tospace. */
+        tc->nursery_allocated_bytes += (char *)tc->nursery_alloc - (char *)tc->nursery_fromspace;
         tc->nursery_alloc       = tc->nursery_tospace;
+        copy_start              = tc->nursery_alloc;
         tc->nursery_alloc_limit = (char *)tc->nursery_tospace + tc->nursery_tospace_size;
 
         /* Add permanent roots and process them; only one thread will do
@@ -171,6 +177,10 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
     /* Destroy the worklist. */
     MVM_gc_worklist_destroy(tc, worklist);
 
+    /* What we copied into tospace was not allocated by the thread, so take
+     * it off the allocation count (it is counted again when tospace flips). */
+    tc->nursery_allocated_bytes -= (char *)tc->nursery_alloc - (char *)copy_start;
+
     /* Pass any work for other threads we accumulated but that didn't trigger
      * the work passing threshold, then cleanup work passing list. */
     if (wtp.num_target_threads) {
@@ -375,6 +385,7 @@ void MVM_gc_mark_collectable(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMC
         /* Add all references in the STable to the work list. */
         MVMSTable *new_addr_st = (MVMSTable *)new_addr;
         MVM_gc_worklist_add(tc, worklist, &new_addr_st->method_cache);
+        MVM_gc_worklist_add(tc, worklist, &new_addr_st->method_table_cache);
         for (i = 0; i < new_addr_st->type_check_cache_length; i++)
             MVM_gc_worklist_add(tc, worklist, &new_addr_st->type_check_cache[i]);
         if (new_addr_st->container_spec)
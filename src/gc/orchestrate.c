@@ -388,6 +388,7 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
     if (MVM_trycas(&tc->instance->gc_start, 0, 1)) {
         MVMThread *last_starter = NULL;
         MVMuint32 num_threads = 0;
+        MVMuint32 i;
 
         /* Stash us as the thread to blame for this GC run (used to give it a
          * potential nursery size boost). */
@@ -439,9 +440,10 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
         uv_cond_broadcast(&tc->instance->cond_gc_start);
         uv_mutex_unlock(&tc->instance->mutex_gc_orchestrate);
 
-        /* If there's an event loop thread, wake it up to participate. */
-        if (tc->instance->event_loop_wakeup)
-            uv_async_send(tc->instance->event_loop_wakeup);
+        /* Wake up any event loop threads, so they participate. */
+        for (i = 0; i < tc->instance->num_event_loops; i++)
+            if (tc->instance->event_loops[i].wakeup)
+                uv_async_send(tc->instance->event_loops[i].wakeup);
 
         /* Wait for other threads to be ready. */
         uv_mutex_lock(&tc->instance->mutex_gc_orchestrate);
@@ -75,16 +75,22 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     add_collectable(tc, worklist, snapshot, tc->instance->compiler_registry, "Compiler registry");
     add_collectable(tc, worklist, snapshot, tc->instance->hll_syms, "HLL symbols");
     add_collectable(tc, worklist, snapshot, tc->instance->clargs, "Command line args");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_todo_queue,
-        "Event loop todo queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_permit_queue,
-        "Event loop permit queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_cancel_queue,
-        "Event loop cancel queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_active, "Event loop active");
+    for (i = 0; i < tc->instance->num_event_loops; i++) {
+        MVMEventLoop *event_loop = &(tc->instance->event_loops[i]);
+        MVMEventLoopSubmission *sub;
+        for (sub = event_loop->submissions; sub; sub = sub->next)
+            add_collectable(tc, worklist, snapshot, sub->task,
+                "Event loop submitted task");
+        for (sub = event_loop->processing; sub; sub = sub->next)
+            add_collectable(tc, worklist, snapshot, sub->task,
+                "Event loop submitted task");
+        add_collectable(tc, worklist, snapshot, event_loop->active, "Event loop active");
+    }
 
     add_collectable(tc, worklist, snapshot, tc->instance->spesh_queue,
         "Specialization log queue");
+    add_collectable(tc, worklist, snapshot, tc->instance->sc_preload_queue,
+        "Serialization context preload queue");
     if (worklist)
         MVM_spesh_plan_gc_mark(tc, tc->instance->spesh_plan, worklist);
 
@@ -116,6 +122,15 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
 
     add_collectable(tc, worklist, snapshot, tc->instance->cached_backend_config,
         "Cached backend configuration hash");
+
+    /* Method dispatch tables point into the method cache they were built
+     * from, which may outlive the STable it was for if they are shared. */
+    for (i = 0; i < MVM_METHOD_TABLE_BUCKETS; i++) {
+        MVMMethodTable *table;
+        for (table = tc->instance->method_tables[i]; table; table = table->next)
+            add_collectable(tc, worklist, snapshot, table->source,
+                "Method dispatch table source");
+    }
 }
 
 /* Adds anything that is a root thanks to being referenced by a thread,
@@ -171,6 +186,15 @@ void MVM_gc_root_add_tc_roots_to_worklist(MVMThreadContext *tc, MVMGCWorklist *w
         }
     }
 
+    /* Strings in the collation sort key cache. */
+    if (tc->collation_key_cache) {
+        MVMint32 i;
+        for (i = 0; i < MVM_COLLATION_KEY_CACHE_ENTRIES; i++)
+            add_collectable(tc, worklist, snapshot,
+                tc->collation_key_cache->entries[i].string,
+                "Collation key cache string");
+    }
+
     /* Profiling data. */
     if (worklist)
         MVM_profile_instrumented_mark_data(tc, worklist);
@@ -136,6 +136,8 @@ void MVM_cross_thread_write_instrument(MVMThreadContext *tc, MVMStaticFrame *sf)
 
 /* Filter out some special cases to reduce noise. */
 static MVMint64 filtered_out(MVMThreadContext *tc, MVMObject *written) {
+    MVMuint32 i;
+
     /* If we're holding locks, exclude by default (unless we were asked to
      * also include these). */
     if (tc->num_locks && !tc->instance->cross_thread_write_logging_include_locked)
@@ -146,9 +148,10 @@ static MVMint64 filtered_out(MVMThreadContext *tc, MVMObject *written) {
         return 1;
 
     /* Write on object from event loop thread is usually shift of invokable. */
-    if (tc->instance->event_loop_thread)
-        if (written->header.owner == tc->instance->event_loop_thread->thread_id)
-            return 1;
+    for (i = 0; i < tc->instance->num_event_loops; i++)
+        if (tc->instance->event_loops[i].thread)
+            if (written->header.owner == tc->instance->event_loops[i].thread->thread_id)
+                return 1;
 
     /* Filter out writes to Sub and Method, since these are almost always just
      * multi-dispatch caches. */
@@ -1,9 +1,27 @@
 #include "moar.h"
+#include "platform/io.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+typedef struct WriteInfo WriteInfo;
 
 /* Data that we keep for an asynchronous socket handle. */
 typedef struct {
     /* The libuv handle to the socket. */
     uv_stream_t *handle;
+
+    /* Writes set up since the event loop last processed the work submitted
+     * to it, which will be submitted together. */
+    WriteInfo **pending_writes;
+    MVMuint32   num_pending_writes;
+    MVMuint32   alloc_pending_writes;
+
+    /* Set while a file is being sent to the socket. Writes set up meanwhile
+     * are held back until it is done, and so is a close. */
+    MVMuint8 sending_file;
+    MVMuint8 close_after_send;
 } MVMIOAsyncSocketData;
 
 /* Info we convey about a read task. */
@@ -15,11 +33,13 @@ typedef struct {
     int               work_idx;
 } ReadInfo;
 
-/* Allocates a buffer of the suggested size. */
+/* Gets a buffer of at least the suggested size from the event loop thread's
+ * buffer pool. */
 static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-    size_t size = suggested_size > 0 ? suggested_size : 4;
-    buf->base   = MVM_malloc(size);
-    buf->len    = size;
+    ReadInfo *ri = (ReadInfo *)handle->data;
+    size_t size  = suggested_size > 0 ? suggested_size : 4;
+    buf->base    = MVM_io_buffer_pool_take(ri->tc, &size);
+    buf->len     = size;
 }
 
 /* Callback used to simply free memory on close. */
@@ -38,6 +58,7 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
         MVMROOT(tc, t, {
         MVMROOT(tc, arr, {
             MVMArray *res_buf;
+            size_t    size = buf->len;
 
             /* Push the sequence number. */
             MVMObject *seq_boxed = MVM_repr_box_int(tc,
@@ -46,9 +67,10 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
 
             /* Produce a buffer and push it. */
             res_buf      = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
-            res_buf->body.slots.i8 = (MVMint8 *)buf->base;
+            res_buf->body.slots.i8 = (MVMint8 *)MVM_io_buffer_pool_hand_over(tc,
+                buf->base, &size, nread);
             res_buf->body.start    = 0;
-            res_buf->body.ssize    = buf->len;
+            res_buf->body.ssize    = size;
             res_buf->body.elems    = nread;
             MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
 
@@ -67,8 +89,7 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_read_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -84,8 +105,7 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
             MVM_repr_push_o(tc, arr, msg_box);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_read_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -221,83 +241,158 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
     });
 
     return task;
 }
 
-/* Info we convey about a write task. */
-typedef struct {
+/* Info we convey about a write task. A write is of one or more buffers that
+ * go out in order; for a vectored write, they are taken out of the list when
+ * the write is queued and checked then, so changes to the list later don't
+ * affect the write. */
+struct WriteInfo {
     MVMOSHandle      *handle;
-    MVMObject        *buf_data;
-    uv_write_t       *req;
-    uv_buf_t          buf;
+    MVMObject       **buffers;
+    uv_buf_t         *bufs;
+    MVMint32          num_bufs;
+    MVMint64          total_bytes;
     MVMThreadContext *tc;
     int               work_idx;
-} WriteInfo;
+};
 
-/* Completion handler for an asynchronous write. */
-static void on_write(uv_write_t *req, int status) {
-    WriteInfo        *wi  = (WriteInfo *)req->data;
-    MVMThreadContext *tc  = wi->tc;
-    MVMObject        *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-    MVMAsyncTask     *t   = MVM_io_eventloop_get_active_work(tc, wi->work_idx);
-    MVM_repr_push_o(tc, arr, t->body.schedulee);
+/* A set of writes to the same socket submitted with a single uv_write. */
+typedef struct {
+    uv_write_t   req;
+    uv_buf_t    *bufs;
+    WriteInfo  **writes;
+    MVMuint32    num_writes;
+} WriteBatch;
+
+/* Sends an error for a write to the task's queue. */
+static void notify_write_error(MVMThreadContext *tc, MVMObject *async_task, const char *error) {
+    MVMROOT(tc, async_task, {
+        MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
+        MVM_repr_push_o(tc, arr, t->body.schedulee);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        MVMROOT(tc, arr, {
+            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                tc->instance->VMString, error);
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+        });
+        MVM_repr_push_o(tc, t->body.queue, arr);
+    });
+}
+
+/* Reports the outcome of a write that was submitted, and removes it from
+ * the active work. */
+static void write_done(MVMThreadContext *tc, WriteInfo *wi, int status) {
     if (status >= 0) {
+        MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVMAsyncTask *t   = MVM_io_eventloop_get_active_work(tc, wi->work_idx);
+        MVM_repr_push_o(tc, arr, t->body.schedulee);
         MVMROOT(tc, arr, {
         MVMROOT(tc, t, {
             MVMObject *bytes_box = MVM_repr_box_int(tc,
                 tc->instance->boot_types.BOOTInt,
-                wi->buf.len);
+                wi->total_bytes);
             MVM_repr_push_o(tc, arr, bytes_box);
         });
         });
         MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVM_repr_push_o(tc, t->body.queue, arr);
     }
     else {
-        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-        MVMROOT(tc, arr, {
-        MVMROOT(tc, t, {
-            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
-                tc->instance->VMString, uv_strerror(status));
-            MVMObject *msg_box = MVM_repr_box_str(tc,
-                tc->instance->boot_types.BOOTStr, msg_str);
-            MVM_repr_push_o(tc, arr, msg_box);
-        });
-        });
+        notify_write_error(tc, (MVMObject *)MVM_io_eventloop_get_active_work(tc, wi->work_idx),
+            uv_strerror(status));
     }
-    MVM_repr_push_o(tc, t->body.queue, arr);
-    MVM_free(wi->req);
+    MVM_free(wi->bufs);
+    wi->bufs = NULL;
     MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
 }
 
-/* Does setup work for an asynchronous write. */
+/* Completion handler for a batch of asynchronous writes. */
+static void on_write(uv_write_t *req, int status) {
+    WriteBatch       *batch = (WriteBatch *)req->data;
+    MVMThreadContext *tc    = batch->writes[0]->tc;
+    MVMuint32 i;
+    for (i = 0; i < batch->num_writes; i++)
+        write_done(tc, batch->writes[i], status);
+    MVM_free(batch->bufs);
+    MVM_free(batch->writes);
+    MVM_free(batch);
+}
+
+/* Submits all the writes pending on a socket as a single uv_write, so that
+ * many small writes, or the pieces of a vectored write, go out together. */
+static void submit_pending_writes(MVMThreadContext *tc, void *data) {
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)data;
+    MVMuint32  num_writes = handle_data->num_pending_writes;
+    WriteBatch *batch;
+    MVMuint32  i;
+    int        num_bufs = 0, r;
+    if (num_writes == 0 || handle_data->sending_file)
+        return;
+
+    /* Take the pending writes as our batch. */
+    batch = MVM_malloc(sizeof(WriteBatch));
+    batch->writes     = handle_data->pending_writes;
+    batch->num_writes = num_writes;
+    batch->req.data   = batch;
+    handle_data->pending_writes       = NULL;
+    handle_data->num_pending_writes   = 0;
+    handle_data->alloc_pending_writes = 0;
+
+    /* If the socket was closed meanwhile, they all fail. */
+    if (!handle_data->handle || uv_is_closing((uv_handle_t *)handle_data->handle)) {
+        for (i = 0; i < num_writes; i++) {
+            WriteInfo *wi = batch->writes[i];
+            notify_write_error(tc, (MVMObject *)MVM_io_eventloop_get_active_work(tc, wi->work_idx),
+                "Cannot write to a closed socket");
+            MVM_free(wi->bufs);
+            wi->bufs = NULL;
+            MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
+        }
+        MVM_free(batch->writes);
+        MVM_free(batch);
+        return;
+    }
+
+    /* Gather up the buffers and write them. */
+    for (i = 0; i < num_writes; i++)
+        num_bufs += batch->writes[i]->num_bufs;
+    batch->bufs = MVM_malloc((num_bufs > 0 ? num_bufs : 1) * sizeof(uv_buf_t));
+    num_bufs = 0;
+    for (i = 0; i < num_writes; i++) {
+        memcpy(batch->bufs + num_bufs, batch->writes[i]->bufs,
+            batch->writes[i]->num_bufs * sizeof(uv_buf_t));
+        num_bufs += batch->writes[i]->num_bufs;
+    }
+    if ((r = uv_write(&(batch->req), handle_data->handle, batch->bufs, num_bufs, on_write)) < 0) {
+        for (i = 0; i < num_writes; i++)
+            write_done(tc, batch->writes[i], r);
+        MVM_free(batch->bufs);
+        MVM_free(batch->writes);
+        MVM_free(batch);
+    }
+}
+
+/* Does setup work for an asynchronous write. Rather than being written right
+ * away, it is added to the writes pending on the socket; those are submitted
+ * together once the event loop has set up all the work it was given. */
 static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
     MVMIOAsyncSocketData *handle_data;
-    MVMArray             *buffer;
     WriteInfo            *wi;
-    char                 *output;
-    int                   output_size, r;
+    MVMint64              i;
 
     /* Ensure not closed. */
     wi = (WriteInfo *)data;
     handle_data = (MVMIOAsyncSocketData *)wi->handle->body.data;
     if (!handle_data->handle || uv_is_closing((uv_handle_t *)handle_data->handle)) {
-        MVMROOT(tc, async_task, {
-            MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-            MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
-            MVM_repr_push_o(tc, arr, t->body.schedulee);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-            MVMROOT(tc, arr, {
-                MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
-                    tc->instance->VMString, "Cannot write to a closed socket");
-                MVMObject *msg_box = MVM_repr_box_str(tc,
-                    tc->instance->boot_types.BOOTStr, msg_str);
-                MVM_repr_push_o(tc, arr, msg_box);
-            });
-            MVM_repr_push_o(tc, t->body.queue, arr);
-        });
+        notify_write_error(tc, async_task, "Cannot write to a closed socket");
         return;
     }
 
@@ -306,50 +401,43 @@ static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
     wi->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
 
     /* Extract buf data. */
-    buffer = (MVMArray *)wi->buf_data;
-    output = (char *)(buffer->body.slots.i8 + buffer->body.start);
-    output_size = (int)buffer->body.elems;
-
-    /* Create and initialize write request. */
-    wi->req           = MVM_malloc(sizeof(uv_write_t));
-    wi->buf           = uv_buf_init(output, output_size);
-    wi->req->data     = data;
-
-    if ((r = uv_write(wi->req, handle_data->handle, &(wi->buf), 1, on_write)) < 0) {
-        /* Error; need to notify. */
-        MVMROOT(tc, async_task, {
-            MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-            MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
-            MVM_repr_push_o(tc, arr, t->body.schedulee);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-            MVMROOT(tc, arr, {
-                MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
-                    tc->instance->VMString, uv_strerror(r));
-                MVMObject *msg_box = MVM_repr_box_str(tc,
-                    tc->instance->boot_types.BOOTStr, msg_str);
-                MVM_repr_push_o(tc, arr, msg_box);
-            });
-            MVM_repr_push_o(tc, t->body.queue, arr);
-        });
+    wi->bufs = MVM_malloc((wi->num_bufs > 0 ? wi->num_bufs : 1) * sizeof(uv_buf_t));
+    for (i = 0; i < wi->num_bufs; i++) {
+        MVMArray *buffer = (MVMArray *)wi->buffers[i];
+        wi->bufs[i] = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+            (unsigned int)buffer->body.elems);
+        wi->total_bytes += buffer->body.elems;
+    }
 
-        /* Cleanup handle. */
-        MVM_free(wi->req);
-        wi->req = NULL;
-        MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
+    /* Queue it up with any other writes to this socket. */
+    if (handle_data->num_pending_writes == handle_data->alloc_pending_writes) {
+        handle_data->alloc_pending_writes = handle_data->alloc_pending_writes
+            ? 2 * handle_data->alloc_pending_writes
+            : 4;
+        handle_data->pending_writes = MVM_realloc(handle_data->pending_writes,
+            handle_data->alloc_pending_writes * sizeof(WriteInfo *));
     }
+    handle_data->pending_writes[handle_data->num_pending_writes++] = wi;
+    if (handle_data->num_pending_writes == 1)
+        MVM_io_eventloop_after_setup(tc, submit_pending_writes, handle_data);
 }
 
 /* Marks objects for a write task. */
 static void write_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
     WriteInfo *wi = (WriteInfo *)data;
+    MVMint32   i;
     MVM_gc_worklist_add(tc, worklist, &wi->handle);
-    MVM_gc_worklist_add(tc, worklist, &wi->buf_data);
+    for (i = 0; i < wi->num_bufs; i++)
+        MVM_gc_worklist_add(tc, worklist, &(wi->buffers[i]));
 }
 
 /* Frees info for a write task. */
 static void write_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
-    if (data)
+    if (data) {
+        MVM_free(((WriteInfo *)data)->buffers);
+        MVM_free(((WriteInfo *)data)->bufs);
         MVM_free(data);
+    }
 }
 
 /* Operations table for async write task. */
@@ -361,29 +449,31 @@ static const MVMAsyncTaskOps write_op_table = {
     write_gc_free
 };
 
-static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
-                                  MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
-    MVMAsyncTask *task;
-    WriteInfo    *wi;
-
-    /* Validate REPRs. */
-    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
-        MVM_exception_throw_adhoc(tc,
-            "asyncwritebytes target queue must have ConcBlockingQueue REPR");
-    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
-        MVM_exception_throw_adhoc(tc,
-            "asyncwritebytes result type must have REPR AsyncTask");
-    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
-        MVM_exception_throw_adhoc(tc, "asyncwritebytes requires a native array to read from");
+/* Checks that something is a buffer we can write from. */
+static void check_write_buffer(MVMThreadContext *tc, MVMObject *buffer, const char *op) {
+    if (MVM_is_null(tc, buffer) || !IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "%s requires a native array to read from", op);
     if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
         && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
-        MVM_exception_throw_adhoc(tc, "asyncwritebytes requires a native array of uint8 or int8");
+        MVM_exception_throw_adhoc(tc, "%s requires a native array of uint8 or int8", op);
+}
+
+/* Creates a write task and hands it to the event loop. For a vectored write,
+ * buf_data is a list of buffers; the buffers in it are taken and checked
+ * once the task exists, so nothing can run between the check and them being
+ * kept in the task. */
+static MVMAsyncTask * queue_write(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                  MVMObject *schedulee, MVMObject *buf_data, MVMint32 vectored,
+                                  MVMObject *async_type, const char *op) {
+    MVMAsyncTask *task;
+    WriteInfo    *wi;
+    MVMint32      num_bufs, i;
 
     /* Create async task handle. */
     MVMROOT(tc, queue, {
     MVMROOT(tc, schedulee, {
     MVMROOT(tc, h, {
-    MVMROOT(tc, buffer, {
+    MVMROOT(tc, buf_data, {
         task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
     });
     });
@@ -394,33 +484,83 @@ static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObjec
     task->body.ops  = &write_op_table;
     wi              = MVM_calloc(1, sizeof(WriteInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
-    MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
     task->body.data = wi;
 
+    /* Take the buffers; if one is bad, the task is just garbage. */
+    num_bufs    = vectored ? (MVMint32)MVM_repr_elems(tc, buf_data) : 1;
+    wi->buffers = MVM_calloc(num_bufs > 0 ? num_bufs : 1, sizeof(MVMObject *));
+    for (i = 0; i < num_bufs; i++) {
+        MVMObject *buffer = vectored ? MVM_repr_at_pos_o(tc, buf_data, i) : buf_data;
+        check_write_buffer(tc, buffer, op);
+        MVM_ASSIGN_REF(tc, &(task->common.header), wi->buffers[i], buffer);
+        wi->num_bufs = i + 1;
+    }
+
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
     });
 
     return task;
 }
 
+static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                  MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes result type must have REPR AsyncTask");
+
+    return queue_write(tc, h, queue, schedulee, buffer, 0, async_type, "asyncwritebytes");
+}
+
+/* Writes a list of buffers, in order, as a single write. */
+static MVMAsyncTask * write_bytes_vectored(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                           MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type) {
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytesv target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytesv result type must have REPR AsyncTask");
+    if (!IS_CONCRETE(buffers) || REPR(buffers)->ID != MVM_REPR_ID_VMArray
+            || ((MVMArrayREPRData *)STABLE(buffers)->REPR_data)->slot_type != MVM_ARRAY_OBJ)
+        MVM_exception_throw_adhoc(tc, "asyncwritebytesv requires a list of buffers");
+
+    return queue_write(tc, h, queue, schedulee, buffers, 1, async_type, "asyncwritebytesv");
+}
+
 /* Info we convey about a socket close task. */
 typedef struct {
     MVMOSHandle *handle;
 } CloseInfo;
 
-/* Does an asynchronous close (since it must run on the event loop). */
-static void close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
-    CloseInfo *ci = (CloseInfo *)data;
-    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)ci->handle->body.data;
-    uv_handle_t *handle = (uv_handle_t *)handle_data->handle;
+/* Closes the socket, after submitting any writes set up before the close. */
+static void close_handle(MVMThreadContext *tc, MVMIOAsyncSocketData *handle_data) {
+    uv_handle_t *handle;
+    submit_pending_writes(tc, handle_data);
+    handle = (uv_handle_t *)handle_data->handle;
     if (handle && !uv_is_closing(handle)) {
         handle_data->handle = NULL;
         uv_close(handle, free_on_close_cb);
     }
 }
 
+/* Does an asynchronous close (since it must run on the event loop). If a
+ * file is being sent, the close happens once that is done. */
+static void close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    CloseInfo *ci = (CloseInfo *)data;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)ci->handle->body.data;
+    if (handle_data->sending_file)
+        handle_data->close_after_send = 1;
+    else
+        close_handle(tc, handle_data);
+}
+
 /* Marks objects for a close task. */
 static void close_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
     CloseInfo *ci = (CloseInfo *)data;
@@ -454,15 +594,336 @@ static MVMint64 close_socket(MVMThreadContext *tc, MVMOSHandle *h) {
     ci = MVM_calloc(1, sizeof(CloseInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), ci->handle, h);
     task->body.data = ci;
-    MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
 
     return 0;
 }
 
+#ifndef _WIN32
+/* Info we convey about sending a file to a socket. The in_fd is our own
+ * duplicate of the file's descriptor, so the file handle being closed does
+ * not pull it out from under the thread pool; -1 once we closed it. */
+typedef struct {
+    MVMOSHandle      *handle;
+    MVMOSHandle      *file;
+    int               in_fd;
+    int               out_fd;
+    MVMint64          offset;
+    MVMint64          length;
+    MVMint64          sent;
+    int               error;
+    uv_write_t        barrier;
+    uv_work_t         work;
+    MVMThreadContext *tc;
+    int               work_idx;
+
+    /* Set by the thread pool when the socket was full, so we need to wait
+     * for it to be writable; and set on the event loop when the task is
+     * cancelled, to be seen by the thread pool. */
+    MVMuint8          blocked;
+    AO_t              cancelled;
+
+    /* Polls a duplicate of the socket's file descriptor (libuv won't poll
+     * the one its stream handle has) while we wait for it to be writable;
+     * NULL until we first need to wait. Also if we are waiting now. */
+    uv_poll_t        *poll;
+    int               poll_fd;
+    MVMuint8          waiting;
+} SendFileInfo;
+
+/* Sends as much of the file as the socket will take; this runs on the libuv
+ * thread pool. The socket is non blocking, so when it is full, we go back to
+ * the event loop to wait until it can take more, rather than holding a
+ * thread pool thread while the peer is slow. */
+static void send_file_work(uv_work_t *req) {
+    SendFileInfo *si = (SendFileInfo *)req->data;
+    si->blocked = 0;
+    while (si->sent < si->length && !MVM_load(&si->cancelled)) {
+        MVMint64 r = MVM_platform_sendfile(si->out_fd, si->in_fd, si->offset + si->sent,
+            si->length - si->sent);
+        if (r > 0) {
+            si->sent += r;
+        }
+        else if (r == 0) {
+            break;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            si->blocked = 1;
+            break;
+        }
+        else if (errno != EINTR) {
+            si->error = uv_translate_sys_error(errno);
+            break;
+        }
+    }
+}
+
+/* Closes the poll handle, if we made one, and its file descriptor. Closing
+ * a poll handle stops it watching the descriptor at once. */
+static void free_poll_cb(uv_handle_t *handle) {
+    MVM_free(handle);
+}
+static void close_poll(SendFileInfo *si) {
+    if (si->poll) {
+        uv_close((uv_handle_t *)si->poll, free_poll_cb);
+        close(si->poll_fd);
+        si->poll = NULL;
+    }
+}
+
+/* Back on the event loop, reports how sending the file went (or that it was
+ * cancelled), then lets the writes or close that were waiting for it go
+ * ahead. */
+static void send_file_done(SendFileInfo *si, int status) {
+    MVMThreadContext     *tc          = si->tc;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)si->handle->body.data;
+    MVMAsyncTask         *t           = MVM_io_eventloop_get_active_work(tc, si->work_idx);
+    close_poll(si);
+    close(si->in_fd);
+    si->in_fd = -1;
+    if (status < 0)
+        si->error = status;
+    if (MVM_load(&si->cancelled)) {
+        MVM_io_eventloop_send_cancellation_notification(tc, t);
+    }
+    else if (si->error < 0) {
+        notify_write_error(tc, (MVMObject *)t, uv_strerror(si->error));
+    }
+    else {
+        MVMROOT(tc, t, {
+            MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVMROOT(tc, arr, {
+                MVMObject *bytes_box = MVM_repr_box_int(tc,
+                    tc->instance->boot_types.BOOTInt, si->sent);
+                MVM_repr_push_o(tc, arr, bytes_box);
+            });
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+    }
+    MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
+    handle_data->sending_file = 0;
+    if (handle_data->close_after_send) {
+        handle_data->close_after_send = 0;
+        close_handle(tc, handle_data);
+    }
+    else {
+        submit_pending_writes(tc, handle_data);
+    }
+}
+
+/* Starts, or continues, sending the file on the thread pool. */
+static void send_file_worked(uv_work_t *req, int status);
+static void send_file_queue(SendFileInfo *si) {
+    int r;
+    si->work.data = si;
+    if ((r = uv_queue_work(si->tc->loop, &(si->work), send_file_work, send_file_worked)) < 0)
+        send_file_done(si, r);
+}
+
+/* Called on the event loop once the socket can take more of the file. */
+static void send_file_writable(uv_poll_t *handle, int status, int events) {
+    SendFileInfo *si = (SendFileInfo *)handle->data;
+    uv_poll_stop(handle);
+    si->waiting = 0;
+    if (status < 0)
+        send_file_done(si, status);
+    else
+        send_file_queue(si);
+}
+
+/* Called on the event loop when the thread pool has sent what it could. If
+ * the socket was full, we wait for it to be writable, then go again. */
+static void send_file_worked(uv_work_t *req, int status) {
+    SendFileInfo *si = (SendFileInfo *)req->data;
+    int           r  = status;
+    if (r < 0 || si->error < 0 || !si->blocked || MVM_load(&si->cancelled)) {
+        send_file_done(si, r);
+        return;
+    }
+    if (!si->poll) {
+        si->poll    = MVM_malloc(sizeof(uv_poll_t));
+        si->poll_fd = dup(si->out_fd);
+        if (si->poll_fd < 0) {
+            r = uv_translate_sys_error(errno);
+            MVM_free(si->poll);
+            si->poll = NULL;
+            send_file_done(si, r);
+            return;
+        }
+        if ((r = uv_poll_init(si->tc->loop, si->poll, si->poll_fd)) < 0) {
+            close(si->poll_fd);
+            MVM_free(si->poll);
+            si->poll = NULL;
+            send_file_done(si, r);
+            return;
+        }
+        si->poll->data = si;
+    }
+    if ((r = uv_poll_start(si->poll, UV_WRITABLE, send_file_writable)) < 0)
+        send_file_done(si, r);
+    else
+        si->waiting = 1;
+}
+
+/* Called once everything written to the socket before the file has gone
+ * out; starts sending the file. */
+static void send_file_start(uv_write_t *req, int status) {
+    SendFileInfo         *si          = (SendFileInfo *)req->data;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)si->handle->body.data;
+    uv_os_fd_t            fd;
+    int                   r           = status;
+    if (r >= 0 && MVM_load(&si->cancelled)) {
+        send_file_done(si, 0);
+        return;
+    }
+    if (r >= 0)
+        r = handle_data->handle
+            ? uv_fileno((uv_handle_t *)handle_data->handle, &fd)
+            : UV_EBADF;
+    if (r < 0) {
+        send_file_done(si, r);
+        return;
+    }
+    si->out_fd = fd;
+    send_file_queue(si);
+}
+
+/* Does setup work for sending a file. Writes set up before it are submitted
+ * first, and then an empty write is used to find out when they have all gone
+ * out, so the file's data is not mixed up with theirs. */
+static void send_file_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    SendFileInfo         *si          = (SendFileInfo *)data;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)si->handle->body.data;
+    uv_buf_t              nothing     = uv_buf_init((char *)"", 0);
+    int                   r;
+
+    /* Ensure not closed, or already sending a file. */
+    if (!handle_data->handle || uv_is_closing((uv_handle_t *)handle_data->handle)) {
+        notify_write_error(tc, async_task, "Cannot send a file to a closed socket");
+        return;
+    }
+    if (handle_data->sending_file) {
+        notify_write_error(tc, async_task, "Already sending a file to this socket");
+        return;
+    }
+
+    /* Add to work in progress. */
+    si->tc       = tc;
+    si->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+
+    /* Get earlier writes going, then wait for them. */
+    submit_pending_writes(tc, handle_data);
+    handle_data->sending_file = 1;
+    si->barrier.data = si;
+    if ((r = uv_write(&(si->barrier), handle_data->handle, &nothing, 1, send_file_start)) < 0)
+        send_file_done(si, r);
+}
+
+/* Cancels sending a file. If we are waiting for the socket to be writable,
+ * we stop now; otherwise the thread pool stops after its current sendfile
+ * call, or the send never starts, and we finish up then. */
+static void send_file_cancel(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    SendFileInfo *si = (SendFileInfo *)data;
+    if (si->work_idx < 0 || MVM_load(&si->cancelled))
+        return;
+    MVM_store(&si->cancelled, 1);
+    if (si->waiting) {
+        uv_poll_stop(si->poll);
+        si->waiting = 0;
+        send_file_done(si, 0);
+    }
+}
+
+/* Marks objects for a send file task. */
+static void send_file_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    SendFileInfo *si = (SendFileInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &si->handle);
+    MVM_gc_worklist_add(tc, worklist, &si->file);
+}
+
+/* Frees info for a send file task, closing the file descriptor if the send
+ * never got going. */
+static void send_file_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data) {
+        SendFileInfo *si = (SendFileInfo *)data;
+        if (si->in_fd >= 0)
+            close(si->in_fd);
+        MVM_free(data);
+    }
+}
+
+/* Operations table for a send file task. */
+static const MVMAsyncTaskOps send_file_op_table = {
+    send_file_setup,
+    NULL,
+    send_file_cancel,
+    send_file_gc_mark,
+    send_file_gc_free
+};
+
+/* Sends a range of a file to the socket. The sendfile calls happen on the
+ * libuv thread pool, as they may wait for the disk; waiting for the socket
+ * to take more happens on the event loop. */
+static MVMAsyncTask * send_file(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                MVMObject *schedulee, MVMOSHandle *file, int fd, MVMint64 offset,
+                                MVMint64 length, MVMObject *async_type) {
+    MVMAsyncTask *task;
+    SendFileInfo *si;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue) {
+        close(fd);
+        MVM_exception_throw_adhoc(tc,
+            "asyncsendfile target queue must have ConcBlockingQueue REPR");
+    }
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask) {
+        close(fd);
+        MVM_exception_throw_adhoc(tc,
+            "asyncsendfile result type must have REPR AsyncTask");
+    }
+
+    /* Create async task handle. */
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, schedulee, {
+    MVMROOT(tc, h, {
+    MVMROOT(tc, file, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    });
+    });
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &send_file_op_table;
+    si              = MVM_calloc(1, sizeof(SendFileInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), si->handle, h);
+    MVM_ASSIGN_REF(tc, &(task->common.header), si->file, file);
+    si->in_fd       = fd;
+    si->offset      = offset;
+    si->length      = length;
+    si->work_idx    = -1;
+    task->body.data = si;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
+    });
+
+    return task;
+}
+#endif
+
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable       = { close_socket };
 static const MVMIOAsyncReadable async_readable = { read_bytes };
-static const MVMIOAsyncWritable async_writable = { write_bytes };
+static const MVMIOAsyncWritable async_writable = { write_bytes, write_bytes_vectored };
+#ifndef _WIN32
+static const MVMIOFileSendable  file_sendable  = { NULL, send_file };
+#else
+static const MVMIOFileSendable  file_sendable  = { NULL, NULL };
+#endif
 static const MVMIOOps op_table = {
     &closable,
     NULL,
@@ -476,6 +937,7 @@ static const MVMIOOps op_table = {
     NULL,
     NULL,
     NULL,
+    &file_sendable,
     NULL,
     NULL
 };
@@ -541,6 +1003,7 @@ static void on_connect(uv_connect_t* req, int status) {
             data->handle                 = (uv_stream_t *)ci->socket;
             result->body.ops             = &op_table;
             result->body.data            = data;
+            result->body.event_loop      = tc->event_loop;
             MVM_repr_push_o(tc, arr, (MVMObject *)result);
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
 
@@ -686,62 +1149,176 @@ typedef struct {
 } ListenInfo;
 
 
+/* Sets up a handle for an accepted connection, which will be processed by
+ * the current event loop, and pushes it onto the result array along with the
+ * peer and socket names. */
+static void push_accepted_connection(MVMThreadContext *tc, MVMObject *arr, uv_tcp_t *client) {
+    MVMROOT(tc, arr, {
+        MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
+        MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
+        data->handle                 = (uv_stream_t *)client;
+        result->body.ops             = &op_table;
+        result->body.data            = data;
+        result->body.event_loop      = tc->event_loop;
+
+        MVM_repr_push_o(tc, arr, (MVMObject *)result);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+
+        MVMROOT(tc, result, {
+            struct sockaddr_storage sockaddr;
+            int name_len = sizeof(struct sockaddr_storage);
+
+            uv_tcp_getpeername(client, (struct sockaddr *)&sockaddr, &name_len);
+            push_name_and_port(tc, &sockaddr, arr);
+
+            uv_tcp_getsockname(client, (struct sockaddr *)&sockaddr, &name_len);
+            push_name_and_port(tc, &sockaddr, arr);
+        });
+    });
+}
+
+/* Pushes the error for a connection that could not be accepted onto the
+ * result array. */
+static void push_accept_error(MVMThreadContext *tc, MVMObject *arr, int r) {
+    MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIO);
+    MVMROOT(tc, arr, {
+        MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+            tc->instance->VMString, uv_strerror(r));
+        MVMObject *msg_box = MVM_repr_box_str(tc,
+            tc->instance->boot_types.BOOTStr, msg_str);
+        MVM_repr_push_o(tc, arr, msg_box);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+    });
+}
+
+#ifndef _WIN32
+/* Info we convey about a connection being handed to another event loop. */
+typedef struct {
+    int fd;
+} AdoptInfo;
+
+/* Opens a TCP handle on this event loop for a connection accepted by another
+ * one, and sends it on to the listener's result handler. */
+static void adopt_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    AdoptInfo    *ai     = (AdoptInfo *)data;
+    uv_tcp_t     *client = MVM_malloc(sizeof(uv_tcp_t));
+    MVMAsyncTask *t      = (MVMAsyncTask *)async_task;
+    MVMObject    *arr;
+    int           r;
+
+    MVMROOT(tc, t, {
+        arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    });
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    uv_tcp_init(loop, client);
+    MVMROOT(tc, arr, {
+    MVMROOT(tc, t, {
+        if ((r = uv_tcp_open(client, ai->fd)) == 0) {
+            ai->fd = -1;
+            push_accepted_connection(tc, arr, client);
+        }
+        else {
+            uv_close((uv_handle_t *)client, free_on_close_cb);
+            push_accept_error(tc, arr, r);
+        }
+    });
+    });
+    MVM_repr_push_o(tc, t->body.queue, arr);
+}
+
+/* Closes the connection if it was never adopted, and frees the info. */
+static void adopt_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data) {
+        AdoptInfo *ai = (AdoptInfo *)data;
+        if (ai->fd >= 0)
+            close(ai->fd);
+        MVM_free(ai);
+    }
+}
+
+/* Operations table for async connection adoption task. */
+static const MVMAsyncTaskOps adopt_op_table = {
+    adopt_setup,
+    NULL,
+    NULL,
+    NULL,
+    adopt_gc_free
+};
+#endif
+
+/* When there are multiple event loops, spreads the connections accepted by a
+ * listener over them, going round robin (so the listening loop keeps its
+ * share). The chosen loop is given a duplicate of the connection's file
+ * descriptor to open its own handle on, and the accepting handle is closed.
+ * Returns non-zero if the connection was handed off. Not available on
+ * Windows, where accepted connections stay on the listening loop. */
+static int hand_off_connection(MVMThreadContext *tc, ListenInfo *li, uv_tcp_t *client) {
+#ifndef _WIN32
+    MVMEventLoop *target;
+    MVMAsyncTask *listen_task, *task;
+    AdoptInfo    *ai;
+    uv_os_fd_t    fd;
+    int           dup_fd;
+
+    if (tc->instance->num_event_loops == 1)
+        return 0;
+    target = MVM_io_eventloop_next(tc);
+    if (target == tc->event_loop)
+        return 0;
+    if (uv_fileno((uv_handle_t *)client, &fd) != 0 || (dup_fd = dup(fd)) < 0)
+        return 0;
+    uv_close((uv_handle_t *)client, free_on_close_cb);
+
+    /* The adopting task reports to the same place as the listener. */
+    listen_task = MVM_io_eventloop_get_active_work(tc, li->work_idx);
+    MVMROOT(tc, listen_task, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTAsync);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, listen_task->body.queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, listen_task->body.schedulee);
+    task->body.ops        = &adopt_op_table;
+    ai                    = MVM_malloc(sizeof(AdoptInfo));
+    ai->fd                = dup_fd;
+    task->body.data       = ai;
+    task->body.event_loop = target;
+    MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
 /* Handles an incoming connection. */
 static void on_connection(uv_stream_t *server, int status) {
     ListenInfo       *li     = (ListenInfo *)server->data;
     MVMThreadContext *tc     = li->tc;
-    MVMObject        *arr    = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-    MVMAsyncTask     *t      = MVM_io_eventloop_get_active_work(tc, li->work_idx);
-
     uv_tcp_t         *client = MVM_malloc(sizeof(uv_tcp_t));
+    MVMObject        *arr;
+    MVMAsyncTask     *t;
     int               r;
+
     uv_tcp_init(tc->loop, client);
+    if ((r = uv_accept(server, (uv_stream_t *)client)) == 0 && hand_off_connection(tc, li, client))
+        return;
 
+    arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    t   = MVM_io_eventloop_get_active_work(tc, li->work_idx);
     MVM_repr_push_o(tc, arr, t->body.schedulee);
-    if ((r = uv_accept(server, (uv_stream_t *)client)) == 0) {
-        /* Allocate and set up handle. */
-        MVMROOT(tc, arr, {
-        MVMROOT(tc, t, {
-            MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
-            MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
-            data->handle                 = (uv_stream_t *)client;
-            result->body.ops             = &op_table;
-            result->body.data            = data;
-
-            MVM_repr_push_o(tc, arr, (MVMObject *)result);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
-
-            MVMROOT(tc, result, {
-                struct sockaddr_storage sockaddr;
-                int name_len = sizeof(struct sockaddr_storage);
-
-                uv_tcp_getpeername(client, (struct sockaddr *)&sockaddr, &name_len);
-                push_name_and_port(tc, &sockaddr, arr);
-
-                uv_tcp_getsockname(client, (struct sockaddr *)&sockaddr, &name_len);
-                push_name_and_port(tc, &sockaddr, arr);
-            });
-        });
-        });
-    }
-    else {
-        uv_close((uv_handle_t*)client, NULL);
-        MVM_free(client);
-        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIO);
-        MVMROOT(tc, arr, {
-        MVMROOT(tc, t, {
-            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
-                tc->instance->VMString, uv_strerror(r));
-            MVMObject *msg_box = MVM_repr_box_str(tc,
-                tc->instance->boot_types.BOOTStr, msg_str);
-            MVM_repr_push_o(tc, arr, msg_box);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-        });
-        });
-    }
+    MVMROOT(tc, arr, {
+    MVMROOT(tc, t, {
+        if (r == 0) {
+            push_accepted_connection(tc, arr, client);
+        }
+        else {
+            uv_close((uv_handle_t*)client, NULL);
+            MVM_free(client);
+            push_accept_error(tc, arr, r);
+        }
+    });
+    });
     MVM_repr_push_o(tc, t->body.queue, arr);
 }
 
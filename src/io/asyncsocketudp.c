@@ -18,11 +18,13 @@ typedef struct {
     int               work_idx;
 } ReadInfo;
 
-/* Allocates a buffer of the suggested size. */
+/* Gets a buffer of at least the suggested size from the event loop thread's
+ * buffer pool. */
 static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-    size_t size = suggested_size > 0 ? suggested_size : 4;
-    buf->base   = MVM_malloc(size);
-    buf->len    = size;
+    ReadInfo *ri = (ReadInfo *)handle->data;
+    size_t size  = suggested_size > 0 ? suggested_size : 4;
+    buf->base    = MVM_io_buffer_pool_take(ri->tc, &size);
+    buf->len     = size;
 }
 
 /* Callback used to simply free memory on close. */
@@ -41,6 +43,7 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
         MVMROOT(tc, t, {
         MVMROOT(tc, arr, {
             MVMArray *res_buf;
+            size_t    size = buf->len;
 
             /* Push the sequence number. */
             MVMObject *seq_boxed = MVM_repr_box_int(tc,
@@ -49,9 +52,10 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
 
             /* Produce a buffer and push it. */
             res_buf      = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
-            res_buf->body.slots.i8 = (MVMint8 *)buf->base;
+            res_buf->body.slots.i8 = (MVMint8 *)MVM_io_buffer_pool_hand_over(tc,
+                buf->base, &size, nread);
             res_buf->body.start    = 0;
-            res_buf->body.ssize    = buf->len;
+            res_buf->body.ssize    = size;
             res_buf->body.elems    = nread;
             MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
 
@@ -70,8 +74,7 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_udp_recv_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -87,8 +90,7 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
             MVM_repr_push_o(tc, arr, msg_box);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_udp_recv_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -192,7 +194,7 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
     });
 
     return task;
@@ -364,7 +366,7 @@ static MVMAsyncTask * write_bytes_to(MVMThreadContext *tc, MVMOSHandle *h, MVMOb
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
     });
 
     return task;
@@ -399,7 +401,7 @@ static MVMint64 close_socket(MVMThreadContext *tc, MVMOSHandle *h) {
     });
     task->body.ops  = &close_op_table;
     task->body.data = data->handle;
-    MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
 
     return 0;
 }
@@ -422,6 +424,7 @@ static const MVMIOOps op_table = {
     NULL,
     NULL,
     NULL,
+    NULL,
     NULL
 };
 
@@ -456,6 +459,7 @@ static void setup_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
             data->handle                 = udp_handle;
             result->body.ops             = &op_table;
             result->body.data            = data;
+            result->body.event_loop      = tc->event_loop;
             MVM_repr_push_o(tc, arr, (MVMObject *)result);
         });
         });
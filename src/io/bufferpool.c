@@ -0,0 +1,91 @@
+#include "moar.h"
+
+/* Reads used to MVM_malloc a buffer per chunk, which was then either handed
+ * to a VMArray or freed. Instead, read buffers are taken from a small pool
+ * kept per thread, in a few fixed sizes. When a read fills most of a buffer,
+ * ownership of it passes to the VMArray and the pool just loses it; when it
+ * fills only a little of it, the data is copied into an exactly sized piece
+ * of memory and the buffer goes back to the pool, so a short read neither
+ * ties up a large buffer nor costs a fresh allocation next time. */
+
+/* Gets the size class for a buffer size, or -1 if it is too big to pool. If
+ * exact is set, the size must match that of the class. */
+static MVMint32 size_class(size_t size, MVMint32 exact) {
+    size_t class_size = MVM_IO_BUFFER_POOL_MIN_SIZE;
+    MVMint32 i;
+    for (i = 0; i < MVM_IO_BUFFER_POOL_CLASSES; i++) {
+        if (size <= class_size)
+            return !exact || size == class_size ? i : -1;
+        class_size *= 4;
+    }
+    return -1;
+}
+
+/* Gets a buffer of at least the requested size, updating the size to that
+ * of the buffer handed back. */
+char * MVM_io_buffer_pool_take(MVMThreadContext *tc, size_t *size) {
+    MVMIOBufferPool *pool = tc->io_buffer_pool;
+    MVMint32 cls = size_class(*size, 0);
+    if (cls < 0)
+        return MVM_malloc(*size);
+    *size = (size_t)MVM_IO_BUFFER_POOL_MIN_SIZE << (2 * cls);
+    if (pool && pool->num_free[cls])
+        return pool->free_buffers[cls][--pool->num_free[cls]];
+    return MVM_malloc(*size);
+}
+
+/* Gives a buffer that is no longer needed back to the pool, freeing it if
+ * the pool for its size is already full, or it was not of a pooled size. */
+void MVM_io_buffer_pool_give(MVMThreadContext *tc, char *buf, size_t size) {
+    MVMIOBufferPool *pool;
+    MVMint32 cls;
+    if (!buf)
+        return;
+    cls = size_class(size, 1);
+    if (cls < 0) {
+        MVM_free(buf);
+        return;
+    }
+    if (!tc->io_buffer_pool)
+        tc->io_buffer_pool = MVM_calloc(1, sizeof(MVMIOBufferPool));
+    pool = tc->io_buffer_pool;
+    if (pool->num_free[cls] < MVM_IO_BUFFER_POOL_PER_CLASS)
+        pool->free_buffers[cls][pool->num_free[cls]++] = buf;
+    else
+        MVM_free(buf);
+}
+
+/* Takes a buffer of the given size that `used` bytes were read into, and
+ * returns the memory to hand over to a VMArray, updating size to the amount
+ * of it allocated. If at least half of the buffer was used then it is
+ * handed over itself; otherwise the data is copied out and the buffer is
+ * given back to the pool. If nothing was used, NULL is returned. */
+char * MVM_io_buffer_pool_hand_over(MVMThreadContext *tc, char *buf, size_t *size, size_t used) {
+    char *result;
+    if (used >= *size / 2 && used > 0)
+        return buf;
+    if (used > 0) {
+        result = MVM_malloc(used);
+        memcpy(result, buf, used);
+    }
+    else {
+        result = NULL;
+    }
+    MVM_io_buffer_pool_give(tc, buf, *size);
+    *size = used;
+    return result;
+}
+
+/* Frees a thread's buffer pool and all the buffers in it. */
+void MVM_io_buffer_pool_destroy(MVMThreadContext *tc) {
+    MVMIOBufferPool *pool = tc->io_buffer_pool;
+    if (pool) {
+        MVMint32 i;
+        MVMuint32 j;
+        for (i = 0; i < MVM_IO_BUFFER_POOL_CLASSES; i++)
+            for (j = 0; j < pool->num_free[i]; j++)
+                MVM_free(pool->free_buffers[i][j]);
+        MVM_free(pool);
+        tc->io_buffer_pool = NULL;
+    }
+}
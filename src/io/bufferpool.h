@@ -0,0 +1,18 @@
+/* Number of size classes of I/O buffers we pool, the smallest of them, and
+ * how many free buffers of each class a thread keeps hold of. Each class is
+ * four times the size of the one before it, so the largest is 256KB. */
+#define MVM_IO_BUFFER_POOL_CLASSES    4
+#define MVM_IO_BUFFER_POOL_MIN_SIZE   4096
+#define MVM_IO_BUFFER_POOL_PER_CLASS  4
+
+/* A per-thread pool of free I/O buffers. The event loop thread has one too,
+ * which is where buffers for async reads come from. */
+struct MVMIOBufferPool {
+    char     *free_buffers[MVM_IO_BUFFER_POOL_CLASSES][MVM_IO_BUFFER_POOL_PER_CLASS];
+    MVMuint32 num_free[MVM_IO_BUFFER_POOL_CLASSES];
+};
+
+char * MVM_io_buffer_pool_take(MVMThreadContext *tc, size_t *size);
+void MVM_io_buffer_pool_give(MVMThreadContext *tc, char *buf, size_t size);
+char * MVM_io_buffer_pool_hand_over(MVMThreadContext *tc, char *buf, size_t *size, size_t used);
+void MVM_io_buffer_pool_destroy(MVMThreadContext *tc);
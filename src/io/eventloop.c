@@ -3,56 +3,137 @@
 /* Asynchronous I/O, timers, file system notifications and signal handlers
  * have their callbacks processed by this event loop. Its job is mostly to
  * fire off work, receive the callbacks, and put stuff into the concurrent
- * work queue of some scheduler or other. It's backed by a thread that is
- * started in the usual way, but never actually ends up in interpreter;
+ * work queue of some scheduler or other. Each loop is backed by a thread that
+ * is started in the usual way, but never actually ends up in interpreter;
  * instead, it enters a libuv event loop "forever", until program exit.
  *
- * Work is sent to the event loop by
+ * Work is sent to the event loop by pushing a submission onto its list with
+ * a CAS, so no locks are taken. Only the push that finds the list empty
+ * needs to wake the loop up; the loop takes everything submitted so far
+ * each time it wakes, so a burst of submissions costs one wake-up.
  */
 
-/* Sets up an async task to be done on the loop. */
-static void setup_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_todo_queue;
-    MVMObject *task_obj;
+/* Sets up the event loop state for an instance. Async work is spread over
+ * the number of event loops asked for with MVM_EVENT_LOOPS (by default, just
+ * one); their threads are only started when they are first given work. */
+void MVM_io_eventloop_init(MVMInstance *instance, const char *num_loops) {
+    int wanted = num_loops && num_loops[0] ? atoi(num_loops) : 1;
+    if (wanted < 1)
+        wanted = 1;
+    else if (wanted > MVM_EVENT_LOOPS_MAX)
+        wanted = MVM_EVENT_LOOPS_MAX;
+    instance->num_event_loops = (MVMuint32)wanted;
+    instance->event_loops     = MVM_calloc(wanted, sizeof(MVMEventLoop));
+}
 
-    MVMROOT(tc, queue, {
-        while (!MVM_is_null(tc, task_obj = MVM_concblockingqueue_poll(tc, queue))) {
-            MVMAsyncTask *task = (MVMAsyncTask *)task_obj;
-            task->body.ops->setup(tc, tc->loop, task_obj, task->body.data);
-        }
-    });
+/* Frees the event loop state of an instance. */
+void MVM_io_eventloop_destroy(MVMInstance *instance) {
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++)
+        MVM_free(instance->event_loops[i].after_setup);
+    MVM_free(instance->event_loops);
+    instance->event_loops = NULL;
 }
 
-/* Performs an async emit permit grant on the loop. */
-static void permit_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_permit_queue;
-    MVMObject *task_arr;
+/* Picks the event loop to put a new piece of work on, going round robin. */
+MVMEventLoop * MVM_io_eventloop_next(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    if (instance->num_event_loops == 1)
+        return &(instance->event_loops[0]);
+    return &(instance->event_loops[MVM_incr(&instance->event_loop_next) % instance->num_event_loops]);
+}
 
-    MVMROOT(tc, queue, {
-        while (!MVM_is_null(tc, task_arr = MVM_concblockingqueue_poll(tc, queue))) {
-            MVMObject *task_obj = MVM_repr_at_pos_o(tc, task_arr, 0);
-            MVMAsyncTask *task = (MVMAsyncTask *)task_obj;
-            if (task->body.ops->permit) {
-                MVMint64 channel = MVM_repr_get_int(tc, MVM_repr_at_pos_o(tc, task_arr, 1));
-                MVMint64 permit = MVM_repr_get_int(tc, MVM_repr_at_pos_o(tc, task_arr, 2));
-                task->body.ops->permit(tc, tc->loop, task_obj, task->body.data, channel, permit);
-            }
-        }
-    });
+/* Pushes a piece of work onto an event loop's submission list, waking the
+ * loop up if the list was empty. No GC allocation is done here, so the task
+ * need not be rooted by the caller. */
+static void submit(MVMThreadContext *tc, MVMEventLoop *event_loop, MVMObject *task_obj,
+                   MVMuint8 kind, MVMint64 channel, MVMint64 permits) {
+    MVMEventLoopSubmission *sub = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+        sizeof(MVMEventLoopSubmission));
+    MVMEventLoopSubmission *head;
+    sub->task    = task_obj;
+    sub->kind    = kind;
+    sub->channel = channel;
+    sub->permits = permits;
+    do {
+        head      = (MVMEventLoopSubmission *)MVM_load(&event_loop->submissions);
+        sub->next = head;
+    } while (MVM_casptr(&event_loop->submissions, head, sub) != head);
+    if (!head)
+        uv_async_send(event_loop->wakeup);
 }
 
-/* Performs an async cancellation on the loop. */
-static void cancel_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_cancel_queue;
-    MVMObject *task_obj;
+/* Takes all of the work submitted to the loop and processes it in the order
+ * it was submitted, setting up, permitting or cancelling tasks. Once all of
+ * it is done, runs anything that asked to be run after setup, such as the
+ * submission of writes that were batched up by the tasks. */
+static void process_submissions(MVMThreadContext *tc) {
+    MVMEventLoop *event_loop = tc->event_loop;
+    MVMEventLoopSubmission *taken, *oldest_first = NULL;
+    MVMuint32 i;
 
-    MVMROOT(tc, queue, {
-        while (!MVM_is_null(tc, task_obj = MVM_concblockingqueue_poll(tc, queue))) {
-            MVMAsyncTask *task = (MVMAsyncTask *)task_obj;
-            if (task->body.ops->cancel)
-                task->body.ops->cancel(tc, tc->loop, task_obj, task->body.data);
+    /* Take the list, which is newest first, and reverse it. */
+    do {
+        taken = (MVMEventLoopSubmission *)MVM_load(&event_loop->submissions);
+    } while (taken && MVM_casptr(&event_loop->submissions, taken, NULL) != taken);
+    while (taken) {
+        MVMEventLoopSubmission *next = taken->next;
+        taken->next  = oldest_first;
+        oldest_first = taken;
+        taken        = next;
+    }
+    event_loop->processing = oldest_first;
+
+    /* Process each item. It is unlinked before the task's operation runs,
+     * so that anything left in processing is marked if the operation GCs. */
+    while (event_loop->processing) {
+        MVMEventLoopSubmission *sub = event_loop->processing;
+        MVMObject    *task_obj = sub->task;
+        MVMAsyncTask *task     = (MVMAsyncTask *)task_obj;
+        MVMuint8      kind     = sub->kind;
+        MVMint64      channel  = sub->channel;
+        MVMint64      permits  = sub->permits;
+        event_loop->processing = sub->next;
+        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMEventLoopSubmission), sub);
+        switch (kind) {
+            case MVM_EVENT_LOOP_SETUP:
+                task->body.ops->setup(tc, tc->loop, task_obj, task->body.data);
+                break;
+            case MVM_EVENT_LOOP_PERMIT:
+                if (task->body.ops->permit)
+                    task->body.ops->permit(tc, tc->loop, task_obj, task->body.data,
+                        channel, permits);
+                break;
+            case MVM_EVENT_LOOP_CANCEL:
+                if (task->body.ops->cancel)
+                    task->body.ops->cancel(tc, tc->loop, task_obj, task->body.data);
+                break;
         }
-    });
+    }
+
+    for (i = 0; i < event_loop->num_after_setup; i++) {
+        MVMEventLoopAfterSetup *after = &(event_loop->after_setup[i]);
+        after->func(tc, after->data);
+    }
+    event_loop->num_after_setup = 0;
+}
+
+/* Asks for a function to be called on the event loop thread once all of the
+ * work it has been given so far has been processed. Only to be called on the
+ * event loop thread, from a task's setup. */
+void MVM_io_eventloop_after_setup(MVMThreadContext *tc,
+        void (*func)(MVMThreadContext *tc, void *data), void *data) {
+    MVMEventLoop *event_loop = tc->event_loop;
+    if (event_loop->num_after_setup == event_loop->alloc_after_setup) {
+        event_loop->alloc_after_setup = event_loop->alloc_after_setup
+            ? 2 * event_loop->alloc_after_setup
+            : 8;
+        event_loop->after_setup = MVM_realloc(event_loop->after_setup,
+            event_loop->alloc_after_setup * sizeof(MVMEventLoopAfterSetup));
+    }
+    event_loop->after_setup[event_loop->num_after_setup].func = func;
+    event_loop->after_setup[event_loop->num_after_setup].data = data;
+    event_loop->num_after_setup++;
 }
 
 /* Fired whenever we were signalled that there is a new task or a new
@@ -60,13 +141,12 @@ static void cancel_work(MVMThreadContext *tc) {
 static void async_handler(uv_async_t *handle) {
     MVMThreadContext *tc = (MVMThreadContext *)handle->data;
     GC_SYNC_POINT(tc);
-    setup_work(tc);
-    permit_work(tc);
-    cancel_work(tc);
+    process_submissions(tc);
 }
 
 /* Enters the event loop. */
 static void enter_loop(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
+    MVMEventLoop *event_loop = tc->event_loop;
     uv_async_t   *async;
 
     /* Set up async handler so we can be woken up when there's new tasks. */
@@ -74,47 +154,41 @@ static void enter_loop(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister
     if (uv_async_init(tc->loop, async, async_handler) != 0)
         MVM_panic(1, "Unable to initialize async wake-up handle for event loop");
     async->data = tc;
-    tc->instance->event_loop_wakeup = async;
+    event_loop->wakeup = async;
 
     /* Signal that the event loop is ready for processing. */
-    uv_sem_post(&(tc->instance->sem_event_loop_started));
+    uv_sem_post(&(event_loop->started));
 
     /* Enter event loop; should never leave it. */
     uv_run(tc->loop, UV_RUN_DEFAULT);
     MVM_panic(1, "Supposedly unending event loop thread ended");
 }
 
-/* Sees if we have an event loop processing thread set up already, and
- * sets it up if not. */
-static uv_loop_t *get_or_vivify_loop(MVMThreadContext *tc) {
+/* Sees if the event loop has a processing thread set up already, and sets
+ * it up if not. */
+static void get_or_vivify_loop(MVMThreadContext *tc, MVMEventLoop *event_loop) {
     MVMInstance *instance = tc->instance;
 
-    if (!instance->event_loop_thread) {
+    if (!event_loop->thread) {
         /* Grab starting mutex and ensure we didn't lose the race. */
         MVM_telemetry_timestamp(tc, "hoping to start an event loop thread");
         MVM_gc_mark_thread_blocked(tc);
         uv_mutex_lock(&instance->mutex_event_loop_start);
         MVM_gc_mark_thread_unblocked(tc);
-        if (!instance->event_loop_thread) {
+        if (!event_loop->thread) {
             MVMObject *thread, *loop_runner;
             int r;
             unsigned int interval_id;
 
-            interval_id = MVM_telemetry_interval_start(tc, "creating the event loop thread");
+            interval_id = MVM_telemetry_interval_start(tc, "creating an event loop thread");
 
-            /* Create various bits of state the async event loop thread needs. */
-            instance->event_loop_todo_queue   = MVM_repr_alloc_init(tc,
-                instance->boot_types.BOOTQueue);
-            instance->event_loop_permit_queue = MVM_repr_alloc_init(tc,
-                instance->boot_types.BOOTQueue);
-            instance->event_loop_cancel_queue = MVM_repr_alloc_init(tc,
-                instance->boot_types.BOOTQueue);
-            instance->event_loop_active       = MVM_repr_alloc_init(tc,
+            /* Create the active task list the event loop thread needs. */
+            event_loop->active = MVM_repr_alloc_init(tc,
                 instance->boot_types.BOOTArray);
 
             /* We need to wait until we know the event loop has started; we'll
              * use a semaphore for this purpose. */
-            if ((r = uv_sem_init(&(instance->sem_event_loop_started), 0)) < 0) {
+            if ((r = uv_sem_init(&(event_loop->started), 0)) < 0) {
                 uv_mutex_unlock(&instance->mutex_event_loop_start);
                 MVM_exception_throw_adhoc(tc, "Failed to initialize event loop start semaphore: %s",
                     uv_strerror(r));
@@ -125,36 +199,58 @@ static uv_loop_t *get_or_vivify_loop(MVMThreadContext *tc) {
             loop_runner = MVM_repr_alloc_init(tc, instance->boot_types.BOOTCCode);
             ((MVMCFunction *)loop_runner)->body.func = enter_loop;
             thread = MVM_thread_new(tc, loop_runner, 1);
+            ((MVMThread *)thread)->body.tc->event_loop = event_loop;
             MVMROOT(tc, thread, {
                 MVM_thread_run(tc, thread);
 
                 /* Block until we know it's fully started and initialized. */
                 MVM_gc_mark_thread_blocked(tc);
-                uv_sem_wait(&(instance->sem_event_loop_started));
+                uv_sem_wait(&(event_loop->started));
                 MVM_gc_mark_thread_unblocked(tc);
-                uv_sem_destroy(&(instance->sem_event_loop_started));
+                uv_sem_destroy(&(event_loop->started));
 
                 /* Make the started event loop thread visible to others. */
-                instance->event_loop_thread = ((MVMThread *)thread)->body.tc;
+                event_loop->thread = ((MVMThread *)thread)->body.tc;
             });
 
-            MVM_telemetry_interval_stop(tc, interval_id, "created the event loop thread");
+            MVM_telemetry_interval_stop(tc, interval_id, "created an event loop thread");
         }
         uv_mutex_unlock(&instance->mutex_event_loop_start);
     }
+}
 
-    return instance->event_loop_thread->loop;
+/* Gets the event loop that a task runs on, choosing one if it has not been
+ * queued yet, and makes sure that loop is running. */
+static MVMEventLoop * task_event_loop(MVMThreadContext *tc, MVMAsyncTask *task) {
+    MVMEventLoop *event_loop = task->body.event_loop;
+    if (!event_loop)
+        event_loop = task->body.event_loop = MVM_io_eventloop_next(tc);
+    MVMROOT(tc, task, {
+        get_or_vivify_loop(tc, event_loop);
+    });
+    return event_loop;
 }
 
-/* Adds a work item into the event loop work queue. */
+/* Adds a work item into the work queue of an event loop. Unless the task was
+ * already placed on a particular loop, one is picked for it. */
 void MVM_io_eventloop_queue_work(MVMThreadContext *tc, MVMObject *work) {
     MVMROOT(tc, work, {
-        get_or_vivify_loop(tc);
-        MVM_repr_push_o(tc, tc->instance->event_loop_todo_queue, work);
-        uv_async_send(tc->instance->event_loop_wakeup);
+        MVMEventLoop *event_loop = task_event_loop(tc, (MVMAsyncTask *)work);
+        submit(tc, event_loop, work, MVM_EVENT_LOOP_SETUP, 0, 0);
     });
 }
 
+/* Adds a work item that operates on an I/O handle. All work on a handle is
+ * done by the same event loop, since libuv handles belong to a loop; if the
+ * handle was not yet bound to a loop, it is bound to the one picked here. */
+void MVM_io_eventloop_queue_handle_work(MVMThreadContext *tc, MVMObject *work,
+                                        MVMOSHandle *handle) {
+    if (!handle->body.event_loop)
+        handle->body.event_loop = MVM_io_eventloop_next(tc);
+    ((MVMAsyncTask *)work)->body.event_loop = handle->body.event_loop;
+    MVM_io_eventloop_queue_work(tc, work);
+}
+
 /* Permits an asynchronous task to emit more events. This is used to provide a
  * back-pressure mechanism. */
 void MVM_io_eventloop_permit(MVMThreadContext *tc, MVMObject *task_obj,
@@ -163,24 +259,8 @@ void MVM_io_eventloop_permit(MVMThreadContext *tc, MVMObject *task_obj,
         task_obj = MVM_io_get_async_task_handle(tc, task_obj);
     if (REPR(task_obj)->ID == MVM_REPR_ID_MVMAsyncTask) {
         MVMROOT(tc, task_obj, {
-            MVMObject *channel_box = NULL;
-            MVMObject *permits_box = NULL;
-            MVMObject *arr = NULL;
-            MVMROOT(tc, channel_box, {
-            MVMROOT(tc, permits_box, {
-            MVMROOT(tc, arr, {
-                channel_box = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, channel);
-                permits_box = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, permits);
-                arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-                MVM_repr_push_o(tc, arr, task_obj);
-                MVM_repr_push_o(tc, arr, channel_box);
-                MVM_repr_push_o(tc, arr, permits_box);
-                get_or_vivify_loop(tc);
-                MVM_repr_push_o(tc, tc->instance->event_loop_permit_queue, arr);
-                uv_async_send(tc->instance->event_loop_wakeup);
-            });
-            });
-            });
+            MVMEventLoop *event_loop = task_event_loop(tc, (MVMAsyncTask *)task_obj);
+            submit(tc, event_loop, task_obj, MVM_EVENT_LOOP_PERMIT, channel, permits);
         });
     }
     else {
@@ -200,9 +280,8 @@ void MVM_io_eventloop_cancel_work(MVMThreadContext *tc, MVMObject *task_obj,
                 notify_schedulee);
         }
         MVMROOT(tc, task_obj, {
-            get_or_vivify_loop(tc);
-            MVM_repr_push_o(tc, tc->instance->event_loop_cancel_queue, task_obj);
-            uv_async_send(tc->instance->event_loop_wakeup);
+            MVMEventLoop *event_loop = task_event_loop(tc, (MVMAsyncTask *)task_obj);
+            submit(tc, event_loop, task_obj, MVM_EVENT_LOOP_CANCEL, 0, 0);
         });
     }
     else {
@@ -220,15 +299,15 @@ void MVM_io_eventloop_send_cancellation_notification(MVMThreadContext *tc, MVMAs
 
 /* Adds a work item to the active async task set. */
 int MVM_io_eventloop_add_active_work(MVMThreadContext *tc, MVMObject *async_task) {
-    int work_idx = MVM_repr_elems(tc, tc->instance->event_loop_active);
-    MVM_repr_push_o(tc, tc->instance->event_loop_active, async_task);
+    int work_idx = MVM_repr_elems(tc, tc->event_loop->active);
+    MVM_repr_push_o(tc, tc->event_loop->active, async_task);
     return work_idx;
 }
 
 /* Gets an active work item from the active work eventloop. */
 MVMAsyncTask * MVM_io_eventloop_get_active_work(MVMThreadContext *tc, int work_idx) {
-    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->instance->event_loop_active)) {
-        MVMObject *task_obj = MVM_repr_at_pos_o(tc, tc->instance->event_loop_active, work_idx);
+    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->event_loop->active)) {
+        MVMObject *task_obj = MVM_repr_at_pos_o(tc, tc->event_loop->active, work_idx);
         if (REPR(task_obj)->ID != MVM_REPR_ID_MVMAsyncTask)
             MVM_panic(1, "non-AsyncTask fetched from eventloop active work list");
         return (MVMAsyncTask *)task_obj;
@@ -243,9 +322,9 @@ MVMAsyncTask * MVM_io_eventloop_get_active_work(MVMThreadContext *tc, int work_i
  * so that any future use of the task will be a failed lookup. */
 void MVM_io_eventloop_remove_active_work(MVMThreadContext *tc, int *work_idx_to_clear) {
     int work_idx = *work_idx_to_clear;
-    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->instance->event_loop_active)) {
+    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->event_loop->active)) {
         *work_idx_to_clear = -1;
-        MVM_repr_bind_pos_o(tc, tc->instance->event_loop_active, work_idx, tc->instance->VMNull);
+        MVM_repr_bind_pos_o(tc, tc->event_loop->active, work_idx, tc->instance->VMNull);
         /* TODO: start to re-use the indices */
     }
     else {
@@ -18,7 +18,73 @@ struct MVMAsyncTaskOps {
     void (*gc_free) (MVMThreadContext *tc, MVMObject *t, void *data);
 };
 
+/* A function to call once the event loop has processed all of the work it
+ * has been given so far, along with the data to pass it. */
+struct MVMEventLoopAfterSetup {
+    void (*func) (MVMThreadContext *tc, void *data);
+    void *data;
+};
+
+/* An event loop. Each one is backed by its own thread, and so its own libuv
+ * loop, and has its own queues of tasks to set up, permit and cancel, along
+ * with an array of the tasks active on it so they are kept GC marked. The
+ * objects are only created when the loop is first needed. */
+struct MVMEventLoop {
+    /* The thread running the loop; NULL until it is started. */
+    MVMThreadContext *thread;
+
+    /* Semaphore used to wait for the loop thread to start. */
+    uv_sem_t started;
+
+    /* Work submitted to the loop, newest first. Any thread may push onto
+     * it; the loop thread takes the whole list at once, and keeps what it
+     * has yet to process, oldest first, in processing. */
+    MVMEventLoopSubmission *submissions;
+    MVMEventLoopSubmission *processing;
+
+    /* The active task list. */
+    MVMObject *active;
+
+    /* Handle used to wake the loop up when there is something new for it. */
+    uv_async_t *wakeup;
+
+    /* Things to run once the loop has processed the work it has been given;
+     * see MVM_io_eventloop_after_setup. */
+    MVMEventLoopAfterSetup *after_setup;
+    MVMuint32               num_after_setup;
+    MVMuint32               alloc_after_setup;
+};
+
+/* A piece of work submitted to an event loop: a task to set up, grant emit
+ * permits to, or cancel. */
+#define MVM_EVENT_LOOP_SETUP    0
+#define MVM_EVENT_LOOP_PERMIT   1
+#define MVM_EVENT_LOOP_CANCEL   2
+struct MVMEventLoopSubmission {
+    /* The next (older) submission. */
+    MVMEventLoopSubmission *next;
+
+    /* The task the work is for. */
+    MVMObject *task;
+
+    /* The channel and number of permits, for a permit. */
+    MVMint64 channel;
+    MVMint64 permits;
+
+    /* What to do; one of the MVM_EVENT_LOOP_* values above. */
+    MVMuint8 kind;
+};
+
+/* The most event loops that MVM_EVENT_LOOPS may ask for. */
+#define MVM_EVENT_LOOPS_MAX 64
+
+void MVM_io_eventloop_init(MVMInstance *instance, const char *num_loops);
+void MVM_io_eventloop_destroy(MVMInstance *instance);
+MVMEventLoop * MVM_io_eventloop_next(MVMThreadContext *tc);
 void MVM_io_eventloop_queue_work(MVMThreadContext *tc, MVMObject *work);
+void MVM_io_eventloop_queue_handle_work(MVMThreadContext *tc, MVMObject *work, MVMOSHandle *handle);
+void MVM_io_eventloop_after_setup(MVMThreadContext *tc,
+    void (*func)(MVMThreadContext *tc, void *data), void *data);
 void MVM_io_eventloop_permit(MVMThreadContext *tc, MVMObject *task_obj,
     MVMint64 channel, MVMint64 permits);
 void MVM_io_eventloop_cancel_work(MVMThreadContext *tc, MVMObject *task_obj,
@@ -1,5 +1,11 @@
 #include "moar.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 /* Delegatory functions that assert we have a capable handle, then delegate
  * through the IO table to the correct operation. */
 
@@ -133,6 +139,128 @@ void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *res
     ((MVMArray *)result)->body.elems    = bytes_read;
 }
 
+/* Validates a file handle that is to be sent from, and the range of it to
+ * send, flushes anything buffered for writing to it, and gets a duplicate of
+ * its file descriptor. The duplicate is taken with the handle's mutex held,
+ * so the file can be closed while it is being sent without the descriptor
+ * being closed (or reused for another file) under the send. Whoever sends
+ * the file owns the duplicate, and closes it. */
+static int file_to_send(MVMThreadContext *tc, MVMObject *file_obj, MVMint64 offset, MVMint64 length) {
+    MVMOSHandle *file = verify_is_handle(tc, file_obj, "send file");
+    int fd;
+    int dup_errno = 0;
+    if (!file->body.ops->seekable || !file->body.ops->introspection)
+        MVM_exception_throw_adhoc(tc, "Can only send from a file handle");
+    if (offset < 0 || length < 0)
+        MVM_exception_throw_adhoc(tc, "Out of range: attempted to send %"PRId64" bytes from offset %"PRId64" of a file",
+            length, offset);
+    MVMROOT(tc, file, {
+        uv_mutex_t *mutex = acquire_mutex(tc, file);
+        if (file->body.ops->sync_writable)
+            file->body.ops->sync_writable->flush(tc, file, 0);
+        fd = (int)file->body.ops->introspection->native_descriptor(tc, file);
+        if (fd >= 0 && (fd = dup(fd)) < 0)
+            dup_errno = errno;
+        release_mutex(tc, mutex);
+    });
+    if (dup_errno)
+        MVM_exception_throw_adhoc(tc, "Failed to send from file handle: %s", strerror(dup_errno));
+    if (fd < 0)
+        MVM_exception_throw_adhoc(tc, "Cannot send from a closed file handle");
+    return fd;
+}
+
+/* Sends a range of a file to a handle, returning the number of bytes sent,
+ * which is only less than asked for if the file ends before the range does.
+ * The file's position is not changed. */
+MVMint64 MVM_io_send_file(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *file,
+                          MVMint64 offset, MVMint64 length) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "send file to");
+    if (handle->body.ops->file_sendable && handle->body.ops->file_sendable->send_file) {
+        MVMint64 sent;
+        MVMROOT(tc, handle, {
+            int fd = file_to_send(tc, file, offset, length);
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            sent = handle->body.ops->file_sendable->send_file(tc, handle, fd, offset, length);
+            release_mutex(tc, mutex);
+        });
+        return sent;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot send a file to this kind of handle");
+}
+
+/* Sends a range of a file to a handle asynchronously. The file handle is kept
+ * alive until it has been sent; it may be closed meanwhile, since the send
+ * uses its own duplicate of the file descriptor. */
+MVMObject * MVM_io_send_file_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                   MVMObject *schedulee, MVMObject *file, MVMint64 offset,
+                                   MVMint64 length, MVMObject *async_type) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "send file to asynchronously");
+    if (handle->body.ops->file_sendable && handle->body.ops->file_sendable->send_file_async) {
+        MVMObject *result;
+        MVMROOT(tc, queue, {
+        MVMROOT(tc, schedulee, {
+        MVMROOT(tc, file, {
+        MVMROOT(tc, async_type, {
+        MVMROOT(tc, handle, {
+            int fd = file_to_send(tc, file, offset, length);
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            result = (MVMObject *)handle->body.ops->file_sendable->send_file_async(tc,
+                handle, queue, schedulee, (MVMOSHandle *)file, fd, offset, length,
+                async_type);
+            release_mutex(tc, mutex);
+        });
+        });
+        });
+        });
+        });
+        return result;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot send a file asynchronously to this kind of handle");
+}
+
+/* Reads up to the specified number of bytes from a handle and adds them to a
+ * decoder, without going through a VMArray and the copy that adding one to
+ * a decoder makes. Where the handle supports it, the read goes straight into
+ * a buffer from the I/O buffer pool, which goes back to the pool once it has
+ * been decoded. Returns the number of bytes read. */
+MVMint64 MVM_io_read_bytes_to_decoder(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *decoder, MVMint64 length) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "read bytes to decoder");
+    MVMint64 bytes_read;
+    size_t buf_size;
+    char *buf;
+
+    MVM_decoder_ensure_decoder(tc, decoder, "decoderaddfh");
+    if (length < 1)
+        MVM_exception_throw_adhoc(tc, "Out of range: attempted to read %"PRId64" bytes from filehandle", length);
+
+    if (handle->body.ops->sync_readable) {
+        MVMROOT(tc, handle, {
+        MVMROOT(tc, decoder, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            if (handle->body.ops->sync_readable->read_into) {
+                buf_size = (size_t)length;
+                buf = MVM_io_buffer_pool_take(tc, &buf_size);
+                bytes_read = handle->body.ops->sync_readable->read_into(tc, handle,
+                    buf, buf_size, length);
+            }
+            else {
+                bytes_read = handle->body.ops->sync_readable->read_bytes(tc, handle, &buf, length);
+                buf_size = 0;
+            }
+            release_mutex(tc, mutex);
+        });
+        });
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot read characters from this kind of handle");
+
+    MVM_decoder_add_pooled_bytes(tc, (MVMDecoder *)decoder, buf, bytes_read, buf_size);
+    return bytes_read;
+}
+
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
     char *output;
@@ -225,6 +353,33 @@ MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle,
         MVM_exception_throw_adhoc(tc, "Cannot write bytes asynchronously to this kind of handle");
 }
 
+MVMObject * MVM_io_write_bytes_vectored_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                              MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write buffers asynchronously");
+    if (buffers == NULL)
+        MVM_exception_throw_adhoc(tc, "Failed to write to filehandle: NULL buffer list given");
+    if (handle->body.ops->async_writable && handle->body.ops->async_writable->write_bytes_vectored) {
+        MVMObject *result;
+        MVMROOT(tc, queue, {
+        MVMROOT(tc, schedulee, {
+        MVMROOT(tc, buffers, {
+        MVMROOT(tc, async_type, {
+        MVMROOT(tc, handle, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            result = (MVMObject *)handle->body.ops->async_writable->write_bytes_vectored(tc,
+                handle, queue, schedulee, buffers, async_type);
+            release_mutex(tc, mutex);
+        });
+        });
+        });
+        });
+        });
+        return result;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot write buffers asynchronously to this kind of handle");
+}
+
 MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
                                         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type,
                                         MVMString *host, MVMint64 port) {
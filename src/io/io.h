@@ -14,6 +14,7 @@ struct MVMIOOps {
     const MVMIOLockable        *lockable;
     const MVMIOIntrospection   *introspection;
     void (*set_buffer_size) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 size);
+    const MVMIOFileSendable    *file_sendable;
 
     /* How to mark the handle's data, if needed. */
     void (*gc_mark) (MVMThreadContext *tc, void *data, MVMGCWorklist *worklist);
@@ -31,6 +32,11 @@ struct MVMIOClosable {
 struct MVMIOSyncReadable {
     MVMint64 (*read_bytes) (MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVMint64 bytes);
     MVMint64 (*eof) (MVMThreadContext *tc, MVMOSHandle *h);
+
+    /* Optional; reads up to the given number of bytes into a buffer that the
+     * caller took from the I/O buffer pool, of size buf_size, giving it back
+     * to the pool if the read fails. */
+    MVMint64 (*read_into) (MVMThreadContext *tc, MVMOSHandle *h, char *buf, size_t buf_size, MVMint64 bytes);
 };
 
 /* I/O operations on handles that can do synchronous writing. */
@@ -50,6 +56,9 @@ struct MVMIOAsyncReadable {
 struct MVMIOAsyncWritable {
     MVMAsyncTask * (*write_bytes) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type);
+    /* Writes a list of buffers as a single write; NULL if not supported. */
+    MVMAsyncTask * (*write_bytes_vectored) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type);
 };
 
 /* I/O operations on handles that can do asynchronous writing to a given
@@ -79,6 +88,19 @@ struct MVMIOLockable {
     void (*unlock) (MVMThreadContext *tc, MVMOSHandle *h);
 };
 
+/* I/O operations on handles that a range of a file can be sent to. Where the
+ * platform allows, the data goes from the file to the handle without being
+ * copied through VM memory at all. The fd passed is a duplicate that the op
+ * takes ownership of; it must be closed once the send is over, including if
+ * the op throws. */
+struct MVMIOFileSendable {
+    MVMint64 (*send_file) (MVMThreadContext *tc, MVMOSHandle *h, int fd,
+        MVMint64 offset, MVMint64 length);
+    MVMAsyncTask * (*send_file_async) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMOSHandle *file, int fd, MVMint64 offset, MVMint64 length,
+        MVMObject *async_type);
+};
+
 /* Various bits of introspection we can perform on a handle. */
 struct MVMIOIntrospection {
     MVMint64 (*is_tty) (MVMThreadContext *tc, MVMOSHandle *h);
@@ -91,11 +113,19 @@ MVMint64 MVM_io_fileno(MVMThreadContext *tc, MVMObject *oshandle);
 void MVM_io_seek(MVMThreadContext *tc, MVMObject *oshandle, MVMint64 offset, MVMint64 flag);
 MVMint64 MVM_io_tell(MVMThreadContext *tc, MVMObject *oshandle);
 void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *result, MVMint64 length);
+MVMint64 MVM_io_send_file(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *file,
+                          MVMint64 offset, MVMint64 length);
+MVMObject * MVM_io_send_file_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                   MVMObject *schedulee, MVMObject *file, MVMint64 offset,
+                                   MVMint64 length, MVMObject *async_type);
+MVMint64 MVM_io_read_bytes_to_decoder(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *decoder, MVMint64 length);
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer);
 void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *output,
     MVMuint64 output_size);
 MVMObject * MVM_io_read_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
     MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type);
+MVMObject * MVM_io_write_bytes_vectored_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+    MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type);
 MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type);
 MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
@@ -344,7 +344,7 @@ static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObjec
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
     });
 
     return task;
@@ -396,7 +396,7 @@ static MVMint64 close_stdin(MVMThreadContext *tc, MVMOSHandle *h) {
         });
         task->body.ops  = &deferred_close_op_table;
         task->body.data = si;
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
         return 0;
     }
     if (si && si->stdin_handle) {
@@ -407,7 +407,7 @@ static MVMint64 close_stdin(MVMThreadContext *tc, MVMOSHandle *h) {
         });
         task->body.ops  = &close_op_table;
         task->body.data = si->stdin_handle;
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
         si->stdin_handle = NULL;
     }
     return 0;
@@ -425,7 +425,7 @@ static void deferred_close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObj
         });
         task->body.ops  = &deferred_close_op_table;
         task->body.data = si;
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
         return;
     }
     if (si->stdin_handle) {
@@ -439,7 +439,7 @@ MVMObject * get_async_task_handle(MVMThreadContext *tc, MVMOSHandle *h) {
 }
 
 /* IO ops table, for async process, populated with functions. */
-static const MVMIOAsyncWritable proc_async_writable = { write_bytes };
+static const MVMIOAsyncWritable proc_async_writable = { write_bytes, NULL };
 static const MVMIOClosable      closable            = { close_stdin };
 static const MVMIOOps proc_op_table = {
     &closable,
@@ -454,6 +454,7 @@ static const MVMIOOps proc_op_table = {
     NULL,
     NULL,
     NULL,
+    NULL,
     proc_async_gc_mark,
     NULL
 };
@@ -517,7 +518,7 @@ static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf)
         size = MVM_bithacks_next_greater_pow2(size + 1);
     }
 
-    buf->base = MVM_malloc(size);
+    buf->base = MVM_io_buffer_pool_take(si->tc, &size);
     buf->len  = size;
 }
 
@@ -545,9 +546,11 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
                 MVMObject *buf_type    = MVM_repr_at_key_o(tc, si->callbacks,
                                             tc->instance->str_consts.buf_type);
                 MVMArray  *res_buf     = (MVMArray *)MVM_repr_alloc_init(tc, buf_type);
-                res_buf->body.slots.i8 = (MVMint8 *)buf->base;
+                size_t     size        = buf->len;
+                res_buf->body.slots.i8 = (MVMint8 *)MVM_io_buffer_pool_hand_over(tc,
+                                            buf->base, &size, nread);
                 res_buf->body.start    = 0;
-                res_buf->body.ssize    = buf->len;
+                res_buf->body.ssize    = size;
                 res_buf->body.elems    = nread;
                 MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
             }
@@ -584,8 +587,7 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_close((uv_handle_t *)handle, NULL);
         if (--si->using == 0)
             MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
@@ -602,8 +604,7 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
             MVM_repr_push_o(tc, arr, msg_box);
         });
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_buffer_pool_give(tc, buf->base, buf->len);
         uv_close((uv_handle_t *)handle, NULL);
         if (--si->using == 0)
             MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
@@ -1009,7 +1010,7 @@ MVMObject * MVM_proc_spawn_async(MVMThreadContext *tc, MVMObject *queue, MVMObje
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, handle, {
-        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, handle);
     });
 
     return (MVMObject *)handle;
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include "platform/io.h"
+#include "platform/mmap.h"
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -26,6 +27,11 @@ typedef struct stat STAT;
 typedef struct _stat STAT;
 #endif
 
+/* Size of the chunks that asynchronous reads of a file are done in. */
+#define ASYNC_READ_CHUNK_SIZE 65536
+
+typedef struct AsyncWriteInfo AsyncWriteInfo;
+
 /* Data that we keep for a file-based handle. */
 typedef struct {
     /* File descriptor. */
@@ -52,6 +58,58 @@ typedef struct {
 
     /* How much of the output buffer has been used so far. */
     size_t output_buffer_used;
+
+    /* If the file was opened for mapped reading, the mapping, its size and
+     * the platform handle for it (only used on Windows), along with the
+     * current read position within it. */
+    char     *mapping;
+    MVMint64  mapping_size;
+    void     *mapping_handle;
+    MVMint64  mapping_pos;
+
+    /* Asynchronous writes to the file waiting to be done, in order, and if
+     * one is being done now. Writes are done one at a time, since they go
+     * through the libuv thread pool and could otherwise overtake each other.
+     * Only used on the event loop thread the handle is bound to. */
+    AsyncWriteInfo *async_writes_head;
+    AsyncWriteInfo *async_writes_tail;
+    MVMuint8        async_write_active;
+
+    /* Number of asynchronous tasks using the file descriptor, along with the
+     * ASYNC_FD_CLOSED flag once the handle is closed. Closing the handle
+     * while tasks are using it leaves the last of them to close the file
+     * descriptor, so a request on the thread pool never goes to some other
+     * file that got the same descriptor number. */
+    AO_t async_fd_users;
+
+#ifdef MVM_HAS_IO_URING
+    /* Is it a regular file, and so worth using the io_uring for? Cleared
+     * if it turns out we can't have one. */
+    MVMuint8 uring_eligible;
+
+    /* Number of reads in a row that read all that they asked for; we start
+     * reading ahead once it looks like the file is being read through. */
+    MVMuint32 full_reads;
+
+    /* The read-ahead buffer (an I/O buffer pool buffer) and its size, how
+     * many bytes we asked to read into it, and, once the read completes, how
+     * many it got and how many of those have been handed out so far. While
+     * the read is in flight, its io_uring operation. */
+    char         *ahead_buffer;
+    size_t        ahead_buffer_size;
+    MVMint64      ahead_requested;
+    MVMint64      ahead_read;
+    MVMint64      ahead_used;
+    MVMIOUringOp *ahead_op;
+
+    /* When a full output buffer is being written, that buffer, how much of
+     * it is being written, and the io_uring operation writing it; we carry
+     * on buffering into another one. Only one write is in flight at a time,
+     * and there is never a write and a read-ahead in flight together. */
+    char         *write_buffer;
+    MVMint64      write_bytes;
+    MVMIOUringOp *write_op;
+#endif
 } MVMIOFileData;
 
 /* Checks if the file is a TTY. */
@@ -66,10 +124,174 @@ static MVMint64 mvm_fileno(MVMThreadContext *tc, MVMOSHandle *h) {
     return (MVMint64)data->fd;
 }
 
+#ifdef MVM_HAS_IO_URING
+/* Frees the read-ahead buffer. */
+static void free_read_ahead(MVMThreadContext *tc, MVMIOFileData *data) {
+    MVM_io_buffer_pool_give(tc, data->ahead_buffer, data->ahead_buffer_size);
+    data->ahead_buffer = NULL;
+}
+
+/* Starts reading ahead the next chunk of the file. We read ahead in chunks
+ * of the largest pooled buffer size, whatever size the reads being done are,
+ * so that each submission to the io_uring covers several of them. If the
+ * io_uring is busy, we just don't read ahead this time. */
+static void start_read_ahead(MVMThreadContext *tc, MVMIOFileData *data) {
+    MVMint64 bytes = MVM_IO_URING_READ_AHEAD_MAX;
+    data->ahead_buffer_size = (size_t)bytes;
+    data->ahead_buffer      = MVM_io_buffer_pool_take(tc, &(data->ahead_buffer_size));
+    data->ahead_requested   = bytes;
+    data->ahead_read        = 0;
+    data->ahead_used        = 0;
+    data->ahead_op          = MVM_io_uring_submit_read(tc, data->fd, data->ahead_buffer,
+        data->ahead_buffer_size, bytes);
+    if (!data->ahead_op) {
+        free_read_ahead(tc, data);
+        if (MVM_load(&tc->instance->io_uring_unavailable))
+            data->uring_eligible = 0;
+    }
+}
+
+/* Waits for any read-ahead in flight to complete. If it failed, it is just
+ * thrown away; the error will show up again if the data is really read. */
+static void complete_read_ahead(MVMThreadContext *tc, MVMIOFileData *data) {
+    if (data->ahead_op) {
+        MVMIOUringOp *op = data->ahead_op;
+        MVMint64 result;
+        data->ahead_op = NULL;
+        result = MVM_io_uring_wait(tc, op);
+        data->ahead_read = result > 0 ? result : 0;
+    }
+}
+
+/* Gets the number of bytes that were read ahead but not yet handed out; the
+ * file position is that far past where the reader thinks it is. */
+static MVMint64 read_ahead_unused(MVMThreadContext *tc, MVMIOFileData *data) {
+    if (!data->ahead_buffer)
+        return 0;
+    complete_read_ahead(tc, data);
+    return data->ahead_read - data->ahead_used;
+}
+
+/* Throws away any read-ahead, putting the file position back to where the
+ * reader thinks it is. Done before anything that uses the file position. */
+static void drop_read_ahead(MVMThreadContext *tc, MVMIOFileData *data) {
+    MVMint64 unused;
+    if (!data->ahead_buffer)
+        return;
+    unused = read_ahead_unused(tc, data);
+    free_read_ahead(tc, data);
+    data->full_reads = 0;
+    if (unused && MVM_platform_lseek(data->fd, -unused, SEEK_CUR) == -1)
+        MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", errno);
+}
+
+/* Hands out bytes from the read-ahead, starting reading the next chunk if we
+ * use them all up. Returns -1 if the read-ahead reached the end of the file,
+ * in which case it is dropped and a real read should be done, since the file
+ * may have grown since. */
+static MVMint64 take_read_ahead(MVMThreadContext *tc, MVMIOFileData *data, char *buf, MVMint64 bytes) {
+    MVMint64 available, taken;
+    complete_read_ahead(tc, data);
+    available = data->ahead_read - data->ahead_used;
+    if (available == 0) {
+        free_read_ahead(tc, data);
+        data->full_reads = 0;
+        return -1;
+    }
+    taken = bytes < available ? bytes : available;
+    memcpy(buf, data->ahead_buffer + data->ahead_used, taken);
+    data->ahead_used += taken;
+    if (data->ahead_used == data->ahead_read) {
+        MVMint32 was_full = data->ahead_read == data->ahead_requested;
+        free_read_ahead(tc, data);
+        if (was_full)
+            start_read_ahead(tc, data);
+    }
+    return taken;
+}
+
+/* Waits for any write of an output buffer in flight to complete, writing
+ * out whatever it didn't manage to. */
+static void perform_write(MVMThreadContext *tc, MVMIOFileData *data, char *buf, MVMint64 bytes);
+static void complete_write(MVMThreadContext *tc, MVMIOFileData *data) {
+    if (data->write_op) {
+        MVMIOUringOp *op = data->write_op;
+        MVMint64 result;
+        data->write_op = NULL;
+        result = MVM_io_uring_wait(tc, op);
+        if (result < 0)
+            MVM_exception_throw_adhoc(tc, "Failed to write bytes to filehandle: %s",
+                strerror((int)-result));
+        data->byte_position += result;
+        if (result < data->write_bytes)
+            perform_write(tc, data, data->write_buffer + result, data->write_bytes - result);
+    }
+}
+
+/* Starts writing out the full output buffer, and swaps in another one to
+ * carry on buffering into. Returns zero if we can't use an io_uring, and
+ * so the caller should just do a normal flush. */
+static MVMint32 start_write(MVMThreadContext *tc, MVMIOFileData *data) {
+    char *buffer;
+    if (!data->uring_eligible)
+        return 0;
+    complete_write(tc, data);
+    drop_read_ahead(tc, data);
+    data->write_op = MVM_io_uring_submit_write(tc, data->fd, data->output_buffer,
+        data->output_buffer_size, data->output_buffer_used);
+    if (!data->write_op) {
+        if (MVM_load(&tc->instance->io_uring_unavailable))
+            data->uring_eligible = 0;
+        return 0;
+    }
+    buffer = data->write_buffer ? data->write_buffer : MVM_malloc(data->output_buffer_size);
+    data->write_buffer       = data->output_buffer;
+    data->write_bytes        = data->output_buffer_used;
+    data->output_buffer      = buffer;
+    data->output_buffer_used = 0;
+    return 1;
+}
+
+/* Waits for anything the handle has in flight on the io_uring, and frees
+ * the buffers; done when the handle is closed. */
+static void finish_uring(MVMThreadContext *tc, MVMIOFileData *data) {
+    complete_write(tc, data);
+    complete_read_ahead(tc, data);
+    if (data->ahead_buffer)
+        free_read_ahead(tc, data);
+    MVM_free(data->write_buffer);
+    data->write_buffer = NULL;
+}
+
+/* Frees the buffers of a handle that was never closed. We can't wait for
+ * anything in flight during GC, so that is abandoned, and its buffer freed
+ * once the kernel is done with it. */
+static void abandon_uring(MVMThreadContext *tc, MVMIOFileData *data) {
+    if (data->ahead_op) {
+        MVM_io_uring_abandon(tc, data->ahead_op);
+        data->ahead_op     = NULL;
+        data->ahead_buffer = NULL;
+    }
+    if (data->write_op) {
+        MVM_io_uring_abandon(tc, data->write_op);
+        data->write_op     = NULL;
+        data->write_buffer = NULL;
+    }
+    if (data->ahead_buffer)
+        free_read_ahead(tc, data);
+    MVM_free(data->write_buffer);
+    data->write_buffer = NULL;
+}
+#endif
+
 /* Performs a write, either because a buffer filled or because we are not
  * buffering output. */
 static void perform_write(MVMThreadContext *tc, MVMIOFileData *data, char *buf, MVMint64 bytes) {
     MVMint64 bytes_written = 0;
+#ifdef MVM_HAS_IO_URING
+    complete_write(tc, data);
+    drop_read_ahead(tc, data);
+#endif
     MVM_gc_mark_thread_blocked(tc);
     while (bytes > 0) {
         int r = write(data->fd, buf, (int)bytes);
@@ -90,6 +312,9 @@ static void perform_write(MVMThreadContext *tc, MVMIOFileData *data, char *buf,
 
 /* Flushes any existing output buffer and clears use back to 0. */
 static void flush_output_buffer(MVMThreadContext *tc, MVMIOFileData *data) {
+#ifdef MVM_HAS_IO_URING
+    complete_write(tc, data);
+#endif
     if (data->output_buffer_used) {
         perform_write(tc, data, data->output_buffer, data->output_buffer_used);
         data->output_buffer_used = 0;
@@ -102,6 +327,9 @@ static void seek(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 offset, MVMint64
     if (!data->seekable)
         MVM_exception_throw_adhoc(tc, "It is not possible to seek this kind of handle");
     flush_output_buffer(tc, data);
+#ifdef MVM_HAS_IO_URING
+    drop_read_ahead(tc, data);
+#endif
     if (MVM_platform_lseek(data->fd, offset, whence) == -1)
         MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", errno);
 }
@@ -114,6 +342,9 @@ static MVMint64 mvm_tell(MVMThreadContext *tc, MVMOSHandle *h) {
         MVMint64 r;
         if ((r = MVM_platform_lseek(data->fd, 0, SEEK_CUR)) == -1)
             MVM_exception_throw_adhoc(tc, "Failed to tell in filehandle: %d", errno);
+#ifdef MVM_HAS_IO_URING
+        r -= read_ahead_unused(tc, data);
+#endif
         return r;
     }
     else {
@@ -123,9 +354,8 @@ static MVMint64 mvm_tell(MVMThreadContext *tc, MVMOSHandle *h) {
 
 /* Reads the specified number of bytes into a the supplied buffer, returning
  * the number actually read. */
-static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out, MVMint64 bytes) {
+static MVMint64 read_into(MVMThreadContext *tc, MVMOSHandle *h, char *buf, size_t buf_size, MVMint64 bytes) {
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
-    char *buf = MVM_malloc(bytes);
     unsigned int interval_id = MVM_telemetry_interval_start(tc, "syncfile.read_to_buffer");
     MVMint32 bytes_read;
 #ifdef _WIN32
@@ -136,16 +366,30 @@ static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out,
         bytes = 16387;
 #endif
     flush_output_buffer(tc, data);
-    MVM_gc_mark_thread_blocked(tc);
-    if ((bytes_read = read(data->fd, buf, bytes)) == -1) {
-        int save_errno = errno;
-        MVM_free(buf);
+    bytes_read = -1;
+#ifdef MVM_HAS_IO_URING
+    if (data->ahead_buffer)
+        bytes_read = take_read_ahead(tc, data, buf, bytes);
+#endif
+    if (bytes_read == -1) {
+        MVM_gc_mark_thread_blocked(tc);
+        if ((bytes_read = read(data->fd, buf, bytes)) == -1) {
+            int save_errno = errno;
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_io_buffer_pool_give(tc, buf, buf_size);
+            MVM_exception_throw_adhoc(tc, "Reading from filehandle failed: %s",
+                strerror(save_errno));
+        }
         MVM_gc_mark_thread_unblocked(tc);
-        MVM_exception_throw_adhoc(tc, "Reading from filehandle failed: %s",
-            strerror(save_errno));
+#ifdef MVM_HAS_IO_URING
+        /* Once it looks like the file is being read through, start reading
+         * the next chunk while this one is being processed. */
+        if (bytes_read < bytes)
+            data->full_reads = 0;
+        else if (data->uring_eligible && ++data->full_reads >= 2)
+            start_read_ahead(tc, data);
+#endif
     }
-    *buf_out = buf;
-    MVM_gc_mark_thread_unblocked(tc);
     MVM_telemetry_interval_annotate(bytes_read, interval_id, "read this many bytes");
     MVM_telemetry_interval_stop(tc, interval_id, "syncfile.read_to_buffer");
     data->byte_position += bytes_read;
@@ -153,10 +397,20 @@ static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out,
         data->eof_reported = 1;
     return bytes_read;
 }
+static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out, MVMint64 bytes) {
+    size_t buf_size = (size_t)bytes;
+    char *buf = MVM_io_buffer_pool_take(tc, &buf_size);
+    MVMint64 bytes_read = read_into(tc, h, buf, buf_size, bytes);
+    *buf_out = MVM_io_buffer_pool_hand_over(tc, buf, &buf_size, bytes_read);
+    return bytes_read;
+}
 
 /* Checks if the end of file has been reached. */
 static MVMint64 mvm_eof(MVMThreadContext *tc, MVMOSHandle *h) {
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+#ifdef MVM_HAS_IO_URING
+    complete_write(tc, data);
+#endif
     if (data->seekable) {
         MVMint64 seek_pos;
         STAT statbuf;
@@ -165,6 +419,9 @@ static MVMint64 mvm_eof(MVMThreadContext *tc, MVMOSHandle *h) {
                 strerror(errno));
         if ((seek_pos = MVM_platform_lseek(data->fd, 0, SEEK_CUR)) == -1)
             MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", errno);
+#ifdef MVM_HAS_IO_URING
+        seek_pos -= read_ahead_unused(tc, data);
+#endif
         /* Comparison with seek_pos for some special files, like those in /proc,
          * which file size is 0 can be false. In that case, we fall back to check
          * file size to detect EOF. */
@@ -183,6 +440,10 @@ static void set_buffer_size(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 size)
     /* Flush and clear up any existing output buffer. */
     flush_output_buffer(tc, data);
     MVM_free(data->output_buffer);
+#ifdef MVM_HAS_IO_URING
+    MVM_free(data->write_buffer);
+    data->write_buffer = NULL;
+#endif
 
     /* Set up new buffer if needed. */
     if (size > 0) {
@@ -199,9 +460,14 @@ static void set_buffer_size(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 size)
 static MVMint64 write_bytes(MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVMint64 bytes) {
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
     if (data->output_buffer_size && data->known_writable) {
-        /* If we can't fit it on the end of the buffer, flush the buffer. */
-        if (data->output_buffer_used + bytes > data->output_buffer_size)
+        /* If we can't fit it on the end of the buffer, flush the buffer. If
+         * we can, we write it out through an io_uring, and carry on. */
+        if (data->output_buffer_used + bytes > data->output_buffer_size) {
+#ifdef MVM_HAS_IO_URING
+            if (!data->output_buffer_used || !start_write(tc, data))
+#endif
             flush_output_buffer(tc, data);
+        }
 
         /* If we can fit it in the buffer now, memcpy it there, and we're
          * done. */
@@ -231,19 +497,63 @@ static void flush(MVMThreadContext *tc, MVMOSHandle *h, MVMint32 sync){
 /* Truncates the file handle. */
 static void truncatefh(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 bytes) {
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+#ifdef MVM_HAS_IO_URING
+    complete_write(tc, data);
+#endif
     if (ftruncate(data->fd, bytes) == -1)
         MVM_exception_throw_adhoc(tc, "Failed to truncate filehandle: %s", strerror(errno));
 }
 
-/* Closes the file. */
+/* Flag in async_fd_users set once the handle is closed. */
+#define ASYNC_FD_CLOSED ((AO_t)1 << (sizeof(AO_t) * 8 - 1))
+
+/* Called when setting up an asynchronous task, to get the file descriptor
+ * for it to use; -1 if the handle is closed. The file descriptor stays open
+ * until the task is done with it. */
+static int async_use_fd(MVMIOFileData *data) {
+    AO_t old;
+    int  fd;
+    do {
+        old = MVM_load(&data->async_fd_users);
+        fd  = data->fd;
+        if ((old & ASYNC_FD_CLOSED) || fd == -1)
+            return -1;
+    } while (MVM_cas(&data->async_fd_users, old, old + 1) != old);
+    return fd;
+}
+
+/* Called on the event loop when an asynchronous task is done with its file
+ * descriptor. If the handle was closed meanwhile, and this was the last task
+ * using it, we close the file descriptor; there's nobody to report an error
+ * closing it to. */
+static void async_done_with_fd(MVMIOFileData *data, int fd) {
+    if (fd != -1 && MVM_decr(&data->async_fd_users) == (ASYNC_FD_CLOSED | 1))
+        close(fd);
+}
+
+/* Checks if the handle was closed, from the event loop. */
+static MVMint32 async_fd_closed(MVMIOFileData *data) {
+    return (MVM_load(&data->async_fd_users) & ASYNC_FD_CLOSED) != 0;
+}
+
+/* Closes the file. If asynchronous tasks are still using the file descriptor,
+ * the last of them closes it. */
 static MVMint64 closefh(MVMThreadContext *tc, MVMOSHandle *h) {
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
     if (data->fd != -1) {
-        int r;
+        int  r = 0;
+        AO_t old;
         flush_output_buffer(tc, data);
         MVM_free(data->output_buffer);
         data->output_buffer = NULL;
-        r = close(data->fd);
+#ifdef MVM_HAS_IO_URING
+        finish_uring(tc, data);
+#endif
+        do {
+            old = MVM_load(&data->async_fd_users);
+        } while (MVM_cas(&data->async_fd_users, old, old | ASYNC_FD_CLOSED) != old);
+        if (!(old & ~ASYNC_FD_CLOSED))
+            r = close(data->fd);
         data->fd = -1;
         if (r == -1)
             MVM_exception_throw_adhoc(tc, "Failed to close filehandle: %s", strerror(errno));
@@ -363,15 +673,622 @@ static void unlock(MVMThreadContext *tc, MVMOSHandle *h) {
 static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
     MVMIOFileData *data = (MVMIOFileData *)d;
     if (data) {
+#ifdef MVM_HAS_IO_URING
+        abandon_uring(tc, data);
+#endif
         MVM_free(data->output_buffer);
         MVM_free(data);
     }
 }
 
+/* Releases the mapping of a mapped file, if it still has one. */
+static void unmap(MVMIOFileData *data) {
+    if (data->mapping) {
+        MVM_platform_unmap_file(data->mapping, data->mapping_handle, data->mapping_size);
+        data->mapping        = NULL;
+        data->mapping_handle = NULL;
+        data->mapping_size   = 0;
+        data->mapping_pos    = 0;
+    }
+}
+
+/* Reads from a file opened for mapped reading. The bytes are sliced out of
+ * the mapping, with no syscall at all. We are marked blocked while copying,
+ * since touching pages not yet in memory may wait on the disk. Once the file
+ * is closed, this and the other mapped ops throw the error the closed file
+ * descriptor would have given. Nothing here checks if the file shrank; see
+ * try_map_file for why it must not. */
+static MVMint64 mapped_read_into(MVMThreadContext *tc, MVMOSHandle *h, char *buf, size_t buf_size, MVMint64 bytes) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    MVMint64 available, bytes_read;
+    if (!data->mapping)
+        MVM_exception_throw_adhoc(tc, "Reading from filehandle failed: %s", strerror(EBADF));
+    available = data->mapping_pos < data->mapping_size
+        ? data->mapping_size - data->mapping_pos
+        : 0;
+    bytes_read = bytes < available ? bytes : available;
+    if ((MVMuint64)bytes_read > (MVMuint64)buf_size)
+        bytes_read = (MVMint64)buf_size;
+    if (bytes_read > 0) {
+        MVM_gc_mark_thread_blocked(tc);
+        memcpy(buf, data->mapping + data->mapping_pos, bytes_read);
+        MVM_gc_mark_thread_unblocked(tc);
+    }
+    data->mapping_pos += bytes_read;
+    data->byte_position += bytes_read;
+    if (bytes_read == 0 && bytes != 0)
+        data->eof_reported = 1;
+    return bytes_read;
+}
+static MVMint64 mapped_read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out, MVMint64 bytes) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    MVMint64 available, to_read;
+    char *buf;
+    if (!data->mapping)
+        MVM_exception_throw_adhoc(tc, "Reading from filehandle failed: %s", strerror(EBADF));
+    available = data->mapping_pos < data->mapping_size
+        ? data->mapping_size - data->mapping_pos
+        : 0;
+    to_read = bytes < available ? bytes : available;
+    buf = MVM_malloc(to_read > 0 ? to_read : 1);
+    *buf_out = buf;
+    return mapped_read_into(tc, h, buf, (size_t)to_read, bytes);
+}
+
+/* Checks if the end of a mapped file has been reached. */
+static MVMint64 mapped_eof(MVMThreadContext *tc, MVMOSHandle *h) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    if (!data->mapping)
+        MVM_exception_throw_adhoc(tc, "Failed to stat file descriptor: %s", strerror(EBADF));
+    return data->mapping_size <= data->mapping_pos;
+}
+
+/* Seeks within a mapped file. As with lseek, it is fine to seek beyond the
+ * end; reads from there just report EOF. */
+static void mapped_seek(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 offset, MVMint64 whence) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    MVMint64 new_pos;
+    if (!data->mapping)
+        MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", EBADF);
+    switch (whence) {
+        case SEEK_SET: new_pos = offset; break;
+        case SEEK_CUR: new_pos = data->mapping_pos + offset; break;
+        case SEEK_END: new_pos = data->mapping_size + offset; break;
+        default:
+            MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", EINVAL);
+    }
+    if (new_pos < 0)
+        MVM_exception_throw_adhoc(tc, "Failed to seek in filehandle: %d", EINVAL);
+    data->mapping_pos = new_pos;
+}
+
+/* Gets the current position in a mapped file. */
+static MVMint64 mapped_tell(MVMThreadContext *tc, MVMOSHandle *h) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    if (!data->mapping)
+        MVM_exception_throw_adhoc(tc, "Failed to tell in filehandle: %d", EBADF);
+    return data->mapping_pos;
+}
+
+/* Closes a mapped file. */
+static MVMint64 mapped_closefh(MVMThreadContext *tc, MVMOSHandle *h) {
+    unmap((MVMIOFileData *)h->body.data);
+    return closefh(tc, h);
+}
+
+/* Frees data associated with a mapped file handle. */
+static void mapped_gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
+    if (d)
+        unmap((MVMIOFileData *)d);
+    gc_free(tc, h, d);
+}
+
+/* Info we convey about an asynchronous read of a file. */
+typedef struct {
+    uv_fs_t           req;
+    MVMOSHandle      *handle;
+    MVMObject        *buf_type;
+    char             *buf;
+    size_t            buf_size;
+    int               seq_number;
+    MVMThreadContext *tc;
+    uv_loop_t        *loop;
+    int               work_idx;
+    MVMuint8          cancelled;
+    int               fd;
+} AsyncReadInfo;
+
+/* Sends an error to an asynchronous task's queue. The result has a slot
+ * before the error message for reads (the buffer), which writes lack. */
+static void push_async_error(MVMThreadContext *tc, MVMAsyncTask *t, MVMint32 is_read, const char *error) {
+    MVMROOT(tc, t, {
+        MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVM_repr_push_o(tc, arr, t->body.schedulee);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        if (is_read)
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVMROOT(tc, arr, {
+            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                tc->instance->VMString, error);
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+        });
+        MVM_repr_push_o(tc, t->body.queue, arr);
+    });
+}
+
+static void on_async_read(uv_fs_t *req);
+
+/* Ends an asynchronous read, letting go of the file descriptor. */
+static void finish_async_read(MVMThreadContext *tc, AsyncReadInfo *ri) {
+    async_done_with_fd((MVMIOFileData *)ri->handle->body.data, ri->fd);
+    ri->fd = -1;
+    MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+}
+
+/* Starts reading the next chunk of the file, from the current position, into
+ * a buffer from the event loop thread's buffer pool. */
+static void async_read_chunk(MVMThreadContext *tc, AsyncReadInfo *ri) {
+    MVMIOFileData *data = (MVMIOFileData *)ri->handle->body.data;
+    uv_buf_t buf;
+    int r;
+    ri->buf_size = ASYNC_READ_CHUNK_SIZE;
+    ri->buf      = MVM_io_buffer_pool_take(tc, &(ri->buf_size));
+    buf          = uv_buf_init(ri->buf, (unsigned int)ri->buf_size);
+    ri->req.data = ri;
+    r = ri->fd == -1 || async_fd_closed(data)
+        ? UV_EBADF
+        : uv_fs_read(ri->loop, &(ri->req), ri->fd, &buf, 1, -1, on_async_read);
+    if (r < 0) {
+        MVM_io_buffer_pool_give(tc, ri->buf, ri->buf_size);
+        ri->buf = NULL;
+        push_async_error(tc, MVM_io_eventloop_get_active_work(tc, ri->work_idx), 1,
+            uv_strerror(r));
+        finish_async_read(tc, ri);
+    }
+}
+
+/* Completion handler for reading a chunk of a file. Sends it on, and starts
+ * reading the next one, until we reach the end of the file. */
+static void on_async_read(uv_fs_t *req) {
+    AsyncReadInfo    *ri    = (AsyncReadInfo *)req->data;
+    MVMThreadContext *tc    = ri->tc;
+    MVMAsyncTask     *t     = MVM_io_eventloop_get_active_work(tc, ri->work_idx);
+    ssize_t           nread = req->result;
+    char             *buf   = ri->buf;
+    uv_fs_req_cleanup(req);
+    ri->buf = NULL;
+
+    /* If the read was cancelled meanwhile, we just clean up. */
+    if (ri->cancelled) {
+        MVM_io_buffer_pool_give(tc, buf, ri->buf_size);
+        finish_async_read(tc, ri);
+        return;
+    }
+
+    if (nread > 0) {
+        MVMROOT(tc, t, {
+            MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVMROOT(tc, arr, {
+                MVMArray *res_buf;
+                size_t    size = ri->buf_size;
+
+                /* Push the sequence number. */
+                MVMObject *seq_boxed = MVM_repr_box_int(tc,
+                    tc->instance->boot_types.BOOTInt, ri->seq_number++);
+                MVM_repr_push_o(tc, arr, seq_boxed);
+
+                /* Produce a buffer and push it. */
+                res_buf      = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
+                res_buf->body.slots.i8 = (MVMint8 *)MVM_io_buffer_pool_hand_over(tc,
+                    buf, &size, nread);
+                res_buf->body.start    = 0;
+                res_buf->body.ssize    = size;
+                res_buf->body.elems    = nread;
+                MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
+
+                /* Finally, no error. */
+                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            });
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+        async_read_chunk(tc, ri);
+    }
+    else if (nread == 0) {
+        MVM_io_buffer_pool_give(tc, buf, ri->buf_size);
+        MVMROOT(tc, t, {
+            MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVMROOT(tc, arr, {
+                MVMObject *final = MVM_repr_box_int(tc,
+                    tc->instance->boot_types.BOOTInt, ri->seq_number);
+                MVM_repr_push_o(tc, arr, final);
+            });
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+        finish_async_read(tc, ri);
+    }
+    else {
+        MVM_io_buffer_pool_give(tc, buf, ri->buf_size);
+        push_async_error(tc, t, 1, uv_strerror(nread));
+        finish_async_read(tc, ri);
+    }
+}
+
+/* Does setup work for an asynchronous read of a file. */
+static void async_read_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    AsyncReadInfo *ri = (AsyncReadInfo *)data;
+    ri->tc       = tc;
+    ri->loop     = loop;
+    ri->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+    async_read_chunk(tc, ri);
+}
+
+/* Stops reading. There is always a read in flight while the task is active,
+ * so we just flag it, and the completion handler cleans up. */
+static void async_read_cancel(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    AsyncReadInfo *ri = (AsyncReadInfo *)data;
+    if (ri->work_idx >= 0)
+        ri->cancelled = 1;
+}
+
+/* Marks objects for an asynchronous read task. */
+static void async_read_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    AsyncReadInfo *ri = (AsyncReadInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &ri->buf_type);
+    MVM_gc_worklist_add(tc, worklist, &ri->handle);
+}
+
+/* Frees info for an asynchronous read task. */
+static void async_read_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data)
+        MVM_free(data);
+}
+
+/* Operations table for an asynchronous read task. */
+static const MVMAsyncTaskOps async_read_op_table = {
+    async_read_setup,
+    NULL,
+    async_read_cancel,
+    async_read_gc_mark,
+    async_read_gc_free
+};
+
+/* Reads the file asynchronously from its current position, in chunks, which
+ * are pushed to the queue, until the end of the file is reached. The reads
+ * are done on the libuv thread pool, so no thread of ours blocks on them. */
+static MVMAsyncTask * read_bytes_async(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                       MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type) {
+    MVMAsyncTask  *task;
+    AsyncReadInfo *ri;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbytes target queue must have ConcBlockingQueue REPR (got %s)",
+            queue->st->debug_name);
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbytes result type must have REPR AsyncTask");
+    if (REPR(buf_type)->ID == MVM_REPR_ID_VMArray) {
+        MVMint32 slot_type = ((MVMArrayREPRData *)STABLE(buf_type)->REPR_data)->slot_type;
+        if (slot_type != MVM_ARRAY_U8 && slot_type != MVM_ARRAY_I8)
+            MVM_exception_throw_adhoc(tc, "asyncreadbytes buffer type must be an array of uint8 or int8");
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "asyncreadbytes buffer type must be an array");
+    }
+
+    /* Anything buffered must be written before we read. */
+    flush_output_buffer(tc, (MVMIOFileData *)h->body.data);
+#ifdef MVM_HAS_IO_URING
+    drop_read_ahead(tc, (MVMIOFileData *)h->body.data);
+#endif
+
+    /* Create async task handle. */
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, schedulee, {
+    MVMROOT(tc, h, {
+    MVMROOT(tc, buf_type, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    });
+    });
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &async_read_op_table;
+    ri              = MVM_calloc(1, sizeof(AsyncReadInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->buf_type, buf_type);
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->handle, h);
+    ri->fd          = async_use_fd((MVMIOFileData *)h->body.data);
+    task->body.data = ri;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
+    });
+
+    return task;
+}
+
+/* Info we convey about an asynchronous write to a file. A write is either of
+ * a single buffer, or, for a vectored write, of a list of buffers that go out
+ * in order. */
+struct AsyncWriteInfo {
+    uv_fs_t           req;
+    MVMOSHandle      *handle;
+    MVMObject        *buf_data;
+    MVMint32          vectored;
+    uv_buf_t         *bufs;
+    MVMint32          num_bufs;
+    MVMint32          cur_buf;
+    MVMint64          total_bytes;
+    MVMThreadContext *tc;
+    uv_loop_t        *loop;
+    int               work_idx;
+    int               fd;
+    AsyncWriteInfo   *next;
+};
+
+static void start_async_write(MVMThreadContext *tc, MVMIOFileData *data);
+
+/* Moves past bytes that have been written, and any empty buffers. */
+static void skip_written(AsyncWriteInfo *wi, size_t written) {
+    while (wi->cur_buf < wi->num_bufs) {
+        uv_buf_t *buf = &(wi->bufs[wi->cur_buf]);
+        if (written < buf->len) {
+            buf->base += written;
+            buf->len  -= written;
+            return;
+        }
+        written -= buf->len;
+        wi->cur_buf++;
+    }
+}
+
+/* Reports the outcome of the write at the head of the queue, removes it,
+ * and starts the next one, if any. */
+static void finish_async_write(MVMThreadContext *tc, MVMIOFileData *data, int status) {
+    AsyncWriteInfo *wi = data->async_writes_head;
+    MVMAsyncTask   *t  = MVM_io_eventloop_get_active_work(tc, wi->work_idx);
+    data->async_writes_head = wi->next;
+    if (!data->async_writes_head)
+        data->async_writes_tail = NULL;
+    wi->next = NULL;
+    if (status >= 0) {
+        MVMROOT(tc, t, {
+            MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVMROOT(tc, arr, {
+                MVMObject *bytes_box = MVM_repr_box_int(tc,
+                    tc->instance->boot_types.BOOTInt,
+                    wi->total_bytes);
+                MVM_repr_push_o(tc, arr, bytes_box);
+            });
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+    }
+    else {
+        push_async_error(tc, t, 0, uv_strerror(status));
+    }
+    MVM_free(wi->bufs);
+    wi->bufs = NULL;
+    async_done_with_fd(data, wi->fd);
+    wi->fd = -1;
+    MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
+    start_async_write(tc, data);
+}
+
+/* Completion handler for an asynchronous write; if not everything got
+ * written, writes the rest. */
+static void on_async_write(uv_fs_t *req) {
+    AsyncWriteInfo   *wi     = (AsyncWriteInfo *)req->data;
+    MVMThreadContext *tc     = wi->tc;
+    MVMIOFileData    *data   = (MVMIOFileData *)wi->handle->body.data;
+    ssize_t           result = req->result;
+    uv_fs_req_cleanup(req);
+    if (result < 0) {
+        finish_async_write(tc, data, (int)result);
+    }
+    else {
+        skip_written(wi, (size_t)result);
+        if (wi->cur_buf == wi->num_bufs)
+            finish_async_write(tc, data, 0);
+        else if (result == 0)
+            finish_async_write(tc, data, UV_EIO);
+        else
+            start_async_write(tc, data);
+    }
+}
+
+/* Starts (or continues) the write at the head of the queue. */
+static void start_async_write(MVMThreadContext *tc, MVMIOFileData *data) {
+    AsyncWriteInfo *wi = data->async_writes_head;
+    int r;
+    if (!wi) {
+        data->async_write_active = 0;
+        return;
+    }
+    data->async_write_active = 1;
+    if (wi->cur_buf == wi->num_bufs) {
+        finish_async_write(tc, data, 0);
+        return;
+    }
+    wi->req.data = wi;
+    r = wi->fd == -1
+        ? UV_EBADF
+        : uv_fs_write(wi->loop, &(wi->req), wi->fd, wi->bufs + wi->cur_buf,
+            wi->num_bufs - wi->cur_buf, -1, on_async_write);
+    if (r < 0)
+        finish_async_write(tc, data, r);
+}
+
+/* Does setup work for an asynchronous write to a file, queueing it behind
+ * any others to the same file. */
+static void async_write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    AsyncWriteInfo *wi          = (AsyncWriteInfo *)data;
+    MVMIOFileData  *handle_data = (MVMIOFileData *)wi->handle->body.data;
+    MVMint64        i;
+
+    /* Add to work in progress. */
+    wi->tc       = tc;
+    wi->loop     = loop;
+    wi->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+
+    /* Extract buf data. */
+    if (wi->vectored) {
+        wi->num_bufs = (MVMint32)MVM_repr_elems(tc, wi->buf_data);
+        wi->bufs     = MVM_malloc((wi->num_bufs > 0 ? wi->num_bufs : 1) * sizeof(uv_buf_t));
+        for (i = 0; i < wi->num_bufs; i++) {
+            MVMArray *buffer = (MVMArray *)MVM_repr_at_pos_o(tc, wi->buf_data, i);
+            wi->bufs[i] = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+                (unsigned int)buffer->body.elems);
+            wi->total_bytes += buffer->body.elems;
+        }
+    }
+    else {
+        MVMArray *buffer = (MVMArray *)wi->buf_data;
+        wi->num_bufs    = 1;
+        wi->bufs        = MVM_malloc(sizeof(uv_buf_t));
+        wi->bufs[0]     = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+            (unsigned int)buffer->body.elems);
+        wi->total_bytes = buffer->body.elems;
+    }
+    skip_written(wi, 0);
+
+    /* Queue it, and start it if nothing else is being written. */
+    if (handle_data->async_writes_tail)
+        handle_data->async_writes_tail->next = wi;
+    else
+        handle_data->async_writes_head = wi;
+    handle_data->async_writes_tail = wi;
+    if (!handle_data->async_write_active)
+        start_async_write(tc, handle_data);
+}
+
+/* Marks objects for an asynchronous write task. */
+static void async_write_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    AsyncWriteInfo *wi = (AsyncWriteInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &wi->handle);
+    MVM_gc_worklist_add(tc, worklist, &wi->buf_data);
+}
+
+/* Frees info for an asynchronous write task. */
+static void async_write_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data) {
+        MVM_free(((AsyncWriteInfo *)data)->bufs);
+        MVM_free(data);
+    }
+}
+
+/* Operations table for an asynchronous write task. */
+static const MVMAsyncTaskOps async_write_op_table = {
+    async_write_setup,
+    NULL,
+    NULL,
+    async_write_gc_mark,
+    async_write_gc_free
+};
+
+/* Creates an asynchronous write task and hands it to the event loop. */
+static MVMAsyncTask * queue_async_write(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                        MVMObject *schedulee, MVMObject *buf_data, MVMint32 vectored,
+                                        MVMObject *async_type) {
+    MVMAsyncTask   *task;
+    AsyncWriteInfo *wi;
+
+    /* Anything written synchronously before must go out first. */
+    flush_output_buffer(tc, (MVMIOFileData *)h->body.data);
+#ifdef MVM_HAS_IO_URING
+    drop_read_ahead(tc, (MVMIOFileData *)h->body.data);
+#endif
+
+    /* Create async task handle. */
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, schedulee, {
+    MVMROOT(tc, h, {
+    MVMROOT(tc, buf_data, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    });
+    });
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &async_write_op_table;
+    wi              = MVM_calloc(1, sizeof(AsyncWriteInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buf_data);
+    wi->vectored    = vectored;
+    wi->fd          = async_use_fd((MVMIOFileData *)h->body.data);
+    task->body.data = wi;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_handle_work(tc, (MVMObject *)task, h);
+    });
+
+    return task;
+}
+
+/* Checks that something is a buffer we can write from. */
+static void check_write_buffer(MVMThreadContext *tc, MVMObject *buffer, const char *op) {
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "%s requires a native array to read from", op);
+    if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "%s requires a native array of uint8 or int8", op);
+}
+
+/* Writes a buffer to the file asynchronously, at its current position. */
+static MVMAsyncTask * write_bytes_async(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                        MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes result type must have REPR AsyncTask");
+    check_write_buffer(tc, buffer, "asyncwritebytes");
+
+    return queue_async_write(tc, h, queue, schedulee, buffer, 0, async_type);
+}
+
+/* Writes a list of buffers to the file asynchronously, in order. */
+static MVMAsyncTask * write_bytes_vectored_async(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                                 MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type) {
+    MVMint64 i, elems;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytesv target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytesv result type must have REPR AsyncTask");
+    if (!IS_CONCRETE(buffers) || REPR(buffers)->ID != MVM_REPR_ID_VMArray
+            || ((MVMArrayREPRData *)STABLE(buffers)->REPR_data)->slot_type != MVM_ARRAY_OBJ)
+        MVM_exception_throw_adhoc(tc, "asyncwritebytesv requires a list of buffers");
+    elems = MVM_repr_elems(tc, buffers);
+    for (i = 0; i < elems; i++)
+        check_write_buffer(tc, MVM_repr_at_pos_o(tc, buffers, i), "asyncwritebytesv");
+
+    return queue_async_write(tc, h, queue, schedulee, buffers, 1, async_type);
+}
+
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable      = { closefh };
-static const MVMIOSyncReadable  sync_readable = { read_bytes, mvm_eof };
+static const MVMIOSyncReadable  sync_readable = { read_bytes, mvm_eof, read_into };
 static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh };
+static const MVMIOAsyncReadable async_readable = { read_bytes_async };
+static const MVMIOAsyncWritable async_writable = { write_bytes_async, write_bytes_vectored_async };
 static const MVMIOSeekable      seekable      = { seek, mvm_tell };
 static const MVMIOLockable      lockable      = { lock, unlock };
 static const MVMIOIntrospection introspection = { is_tty, mvm_fileno };
@@ -380,8 +1297,8 @@ static const MVMIOOps op_table = {
     &closable,
     &sync_readable,
     &sync_writable,
-    NULL,
-    NULL,
+    &async_readable,
+    &async_writable,
     NULL,
     &seekable,
     NULL,
@@ -390,13 +1307,69 @@ static const MVMIOOps op_table = {
     &introspection,
     &set_buffer_size,
     NULL,
+    NULL,
     gc_free
 };
 
-/* Builds POSIX flag from mode string. */
-static int resolve_open_mode(int *flag, const char *cp) {
+/* IO ops table for files opened for mapped reading. They are read only, and
+ * reads, seeks and EOF checks are served from the mapping. */
+static const MVMIOClosable      mapped_closable      = { mapped_closefh };
+static const MVMIOSyncReadable  mapped_sync_readable = { mapped_read_bytes, mapped_eof, mapped_read_into };
+static const MVMIOSeekable      mapped_seekable      = { mapped_seek, mapped_tell };
+
+static const MVMIOOps mapped_op_table = {
+    &mapped_closable,
+    &mapped_sync_readable,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    &mapped_seekable,
+    NULL,
+    NULL,
+    &lockable,
+    &introspection,
+    &set_buffer_size,
+    NULL,
+    NULL,
+    mapped_gc_free
+};
+
+/* Tries to map a file that was opened for reading. This only succeeds for a
+ * non-empty regular file; otherwise we return 0, and the handle is left to
+ * read through the file descriptor as usual. The mapping covers the size
+ * the file had when opened; anything appended later is not seen. Opening a
+ * file with "rm" is a promise that it will not be truncated or shrunk while
+ * the handle is open: reading a page of the mapping that is no longer backed
+ * by the file raises SIGBUS (on Windows, an access violation), which kills
+ * the process. Use plain "r" for files that may change under you. */
+static MVMint32 try_map_file(MVMIOFileData *data, STAT *statbuf) {
+    if ((statbuf->st_mode & S_IFMT) != S_IFREG || statbuf->st_size <= 0
+            || (MVMuint64)statbuf->st_size > (MVMuint64)SIZE_MAX)
+        return 0;
+    data->mapping = MVM_platform_map_file(data->fd, &data->mapping_handle,
+        (size_t)statbuf->st_size, 0);
+    if (!data->mapping)
+        return 0;
+    data->mapping_size = statbuf->st_size;
+    data->mapping_pos  = 0;
+    MVM_platform_advise_sequential(data->mapping, (size_t)data->mapping_size);
+    return 1;
+}
+
+/* Builds POSIX flag from mode string. A mode of "rm" asks for the file to be
+ * memory mapped for reading, which is reported through `mapped`; the file
+ * must then not shrink while it is open (see try_map_file). */
+static int resolve_open_mode(int *flag, int *mapped, const char *cp) {
+    *mapped = 0;
     switch (*cp++) {
-        case 'r': *flag = O_RDONLY; break;
+        case 'r':
+        *flag = O_RDONLY;
+        if (*cp == 'm') {
+            *mapped = 1;
+            return !cp[1];
+        }
+        break;
         case '-': *flag = O_WRONLY; break;
         case '+': *flag = O_RDWR;   break;
 
@@ -428,11 +1401,13 @@ MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMStrin
     char * const fname = MVM_string_utf8_c8_encode_C_string(tc, filename);
     int fd;
     int flag;
+    int mapped;
+    int have_stat;
     STAT statbuf;
 
     /* Resolve mode description to flags. */
     char * const fmode  = MVM_string_utf8_encode_C_string(tc, mode);
-    if (!resolve_open_mode(&flag, fmode)) {
+    if (!resolve_open_mode(&flag, &mapped, fmode)) {
         char *waste[] = { fname, fmode, NULL };
         MVM_exception_throw_adhoc_free(tc, waste,
             "Invalid open mode for file %s: %s", fname, fmode);
@@ -454,7 +1429,8 @@ MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMStrin
         already have triggered when opening the file, and we can't do anything
         about the others; a failure also does not necessarily imply that the
         file descriptor cannot be used for reading/writing. */
-    if (fstat(fd, &statbuf) == 0 && (statbuf.st_mode & S_IFMT) == S_IFDIR) {
+    have_stat = fstat(fd, &statbuf) == 0;
+    if (have_stat && (statbuf.st_mode & S_IFMT) == S_IFDIR) {
         char *waste[] = { fname, NULL };
         if (close(fd) == -1) {
             const char *err = strerror(errno);
@@ -473,8 +1449,14 @@ MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMStrin
             tc->instance->boot_types.BOOTIO);
         data->fd          = fd;
         data->seekable    = MVM_platform_lseek(fd, 0, SEEK_CUR) != -1;
-        result->body.ops  = &op_table;
+        result->body.ops  = mapped && have_stat && try_map_file(data, &statbuf)
+            ? &mapped_op_table
+            : &op_table;
         result->body.data = data;
+#ifdef MVM_HAS_IO_URING
+        data->uring_eligible = data->seekable && result->body.ops == &op_table
+            && have_stat && (statbuf.st_mode & S_IFMT) == S_IFREG;
+#endif
         return (MVMObject *)result;
     }
 }
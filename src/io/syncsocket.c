@@ -1,4 +1,5 @@
 #include "moar.h"
+#include "platform/io.h"
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -23,6 +24,9 @@
  * structure below. */
 #define PACKET_SIZE 65535
 
+/* Size of the pooled buffer a packet is received into. */
+#define PACKET_BUFFER_SIZE 65536
+
 /* Error handling varies between POSIX and WinSock. */
 MVM_NO_RETURN static void throw_error(MVMThreadContext *tc, int r, char *operation) MVM_NO_RETURN_GCC;
 #ifdef _WIN32
@@ -65,14 +69,15 @@ typedef struct {
 /* Read a packet worth of data into the last packet buffer. */
 static void read_one_packet(MVMThreadContext *tc, MVMIOSyncSocketData *data) {
     unsigned int interval_id = MVM_telemetry_interval_start(tc, "syncsocket.read_one_packet");
+    size_t buffer_size = PACKET_BUFFER_SIZE;
     int r;
+    data->last_packet = MVM_io_buffer_pool_take(tc, &buffer_size);
     MVM_gc_mark_thread_blocked(tc);
-    data->last_packet = MVM_malloc(PACKET_SIZE);
     r = recv(data->handle, data->last_packet, PACKET_SIZE, 0);
     MVM_gc_mark_thread_unblocked(tc);
     MVM_telemetry_interval_stop(tc, interval_id, "syncsocket.read_one_packet");
     if (MVM_IS_SOCKET_ERROR(r) || r == 0) {
-        MVM_free(data->last_packet);
+        MVM_io_buffer_pool_give(tc, data->last_packet, PACKET_BUFFER_SIZE);
         data->last_packet = NULL;
         if (r != 0)
             throw_error(tc, r, "receive data from socket");
@@ -103,7 +108,7 @@ MVMint64 socket_read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVM
             *buf = MVM_malloc(bytes);
             memcpy(*buf, data->last_packet + data->last_packet_start, bytes);
             if (bytes == last_remaining) {
-                MVM_free(data->last_packet);
+                MVM_io_buffer_pool_give(tc, data->last_packet, PACKET_BUFFER_SIZE);
                 data->last_packet = NULL;
             }
             else {
@@ -134,9 +139,10 @@ MVMint64 socket_read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVM
         *buf = MVM_malloc(bytes);
         memcpy(*buf, use_last_packet + use_last_packet_start, last_available);
         memcpy(*buf + last_available, data->last_packet, bytes - last_available);
+        MVM_io_buffer_pool_give(tc, use_last_packet, PACKET_BUFFER_SIZE);
         if (bytes == available) {
             /* We used all of the just-read packet. */
-            MVM_free(data->last_packet);
+            MVM_io_buffer_pool_give(tc, data->last_packet, PACKET_BUFFER_SIZE);
             data->last_packet = NULL;
         }
         else {
@@ -147,9 +153,12 @@ MVMint64 socket_read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVM
     else if (data->last_packet) {
         /* Only data from the just-read packet. */
         if (bytes >= data->last_packet_end) {
-            /* We need all of it, so no copying needed, just hand it back. */
-            *buf = data->last_packet;
+            /* We need all of it, so hand it back; it is only copied if it
+             * would leave most of the buffer unused. */
+            size_t buffer_size = PACKET_BUFFER_SIZE;
             bytes = data->last_packet_end;
+            *buf = MVM_io_buffer_pool_hand_over(tc, data->last_packet,
+                &buffer_size, bytes);
             data->last_packet = NULL;
         }
         else {
@@ -165,6 +174,7 @@ MVMint64 socket_read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVM
         bytes = use_last_packet_end - use_last_packet_start;
         *buf = MVM_malloc(bytes);
         memcpy(*buf, use_last_packet + use_last_packet_start, bytes);
+        MVM_io_buffer_pool_give(tc, use_last_packet, PACKET_BUFFER_SIZE);
         data->eof = 1;
     }
     else {
@@ -216,6 +226,84 @@ MVMint64 socket_write_bytes(MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVM
     return bytes;
 }
 
+/* Sends a range of a file to the socket. The file descriptor is ours, and is
+ * closed however the send ends. */
+static MVMint64 socket_send_file(MVMThreadContext *tc, MVMOSHandle *h, int fd,
+                                 MVMint64 offset, MVMint64 length) {
+    MVMIOSyncSocketData *data = (MVMIOSyncSocketData *)h->body.data;
+    MVMint64 sent = 0;
+    unsigned int interval_id;
+#ifdef _WIN32
+    /* No sendfile here, so we read the file into a buffer and send it. To
+     * not disturb the file position, we put it back after each read. */
+    char *buf = MVM_malloc(PACKET_BUFFER_SIZE);
+    interval_id = MVM_telemetry_interval_start(tc, "syncsocket.send_file");
+    MVM_gc_mark_thread_blocked(tc);
+    while (sent < length) {
+        MVMint64 pos = MVM_platform_lseek(fd, 0, SEEK_CUR);
+        int want = length - sent > PACKET_BUFFER_SIZE ? PACKET_BUFFER_SIZE : (int)(length - sent);
+        int got, pos_sent = 0;
+        if (pos == -1 || MVM_platform_lseek(fd, offset + sent, SEEK_SET) == -1) {
+            int save_errno = errno;
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_free(buf);
+            _close(fd);
+            MVM_exception_throw_adhoc(tc, "Failed to seek in file to send: %s", strerror(save_errno));
+        }
+        got = _read(fd, buf, want);
+        MVM_platform_lseek(fd, pos, SEEK_SET);
+        if (got < 0) {
+            int save_errno = errno;
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_free(buf);
+            _close(fd);
+            MVM_exception_throw_adhoc(tc, "Failed to read file to send: %s", strerror(save_errno));
+        }
+        if (got == 0)
+            break;
+        while (pos_sent < got) {
+            int r = send(data->handle, buf + pos_sent, got - pos_sent, 0);
+            if (MVM_IS_SOCKET_ERROR(r)) {
+                MVM_gc_mark_thread_unblocked(tc);
+                MVM_free(buf);
+                _close(fd);
+                MVM_telemetry_interval_stop(tc, interval_id, "syncsocket.send_file");
+                throw_error(tc, r, "send file to socket");
+            }
+            pos_sent += r;
+        }
+        sent += got;
+    }
+    MVM_gc_mark_thread_unblocked(tc);
+    MVM_free(buf);
+    _close(fd);
+#else
+    interval_id = MVM_telemetry_interval_start(tc, "syncsocket.send_file");
+    MVM_gc_mark_thread_blocked(tc);
+    while (sent < length) {
+        MVMint64 r = MVM_platform_sendfile(data->handle, fd, offset + sent, length - sent);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0) {
+            int save_errno = errno;
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_telemetry_interval_stop(tc, interval_id, "syncsocket.send_file");
+            close(fd);
+            errno = save_errno;
+            throw_error(tc, (int)r, "send file to socket");
+        }
+        if (r == 0)
+            break;
+        sent += r;
+    }
+    MVM_gc_mark_thread_unblocked(tc);
+    close(fd);
+#endif
+    MVM_telemetry_interval_annotate(sent, interval_id, "sent this many bytes");
+    MVM_telemetry_interval_stop(tc, interval_id, "syncsocket.send_file");
+    return sent;
+}
+
 static MVMint64 do_close(MVMThreadContext *tc, MVMIOSyncSocketData *data) {
     if (data->handle) {
         closesocket(data->handle);
@@ -230,6 +318,7 @@ static MVMint64 close_socket(MVMThreadContext *tc, MVMOSHandle *h) {
 static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
     MVMIOSyncSocketData *data = (MVMIOSyncSocketData *)d;
     do_close(tc, data);
+    MVM_io_buffer_pool_give(tc, data->last_packet, PACKET_BUFFER_SIZE);
     MVM_free(data);
 }
 
@@ -430,10 +519,13 @@ static MVMObject * socket_accept(MVMThreadContext *tc, MVMOSHandle *h);
 /* IO ops table, populated with functions. */
 static const MVMIOClosable     closable      = { close_socket };
 static const MVMIOSyncReadable sync_readable = { socket_read_bytes,
-                                                 socket_eof };
+                                                 socket_eof,
+                                                 NULL };
 static const MVMIOSyncWritable sync_writable = { socket_write_bytes,
                                                  socket_flush,
                                                  socket_truncate };
+static const MVMIOFileSendable file_sendable = { socket_send_file,
+                                                 NULL };
 static const MVMIOSockety            sockety = { socket_connect,
                                                  socket_bind,
                                                  socket_accept,
@@ -451,6 +543,7 @@ static const MVMIOOps op_table = {
     NULL,
     NULL,
     NULL,
+    &file_sendable,
     NULL,
     gc_free
 };
@@ -0,0 +1,281 @@
+#include "moar.h"
+
+/* We talk to the kernel through the raw io_uring system calls and the shared
+ * memory rings, rather than depending on liburing; we need little enough of
+ * it that this is easy. */
+
+#ifdef MVM_HAS_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+/* Gives up on io_uring for the whole VM, closing the ring fd if we got one. */
+static MVMIOUring * unavailable(MVMThreadContext *tc, int fd) {
+    if (fd >= 0)
+        close(fd);
+    MVM_store(&tc->instance->io_uring_unavailable, 1);
+    return NULL;
+}
+
+/* Creates an io_uring, or returns NULL if the kernel won't give us one. We
+ * need reads and writes at offset -1 to use and update the file position,
+ * like read and write do, and for the rings to be in a single mapping. */
+static MVMIOUring * create(MVMThreadContext *tc) {
+    struct io_uring_params params;
+    MVMIOUring *ring;
+    size_t sq_size, cq_size;
+    char *rings;
+    void *sqes;
+    int fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = io_uring_setup(MVM_IO_URING_ENTRIES, &params);
+    if (fd < 0)
+        return unavailable(tc, -1);
+    if (!(params.features & IORING_FEAT_RW_CUR_POS) || !(params.features & IORING_FEAT_SINGLE_MMAP))
+        return unavailable(tc, fd);
+
+    /* Map the rings and the submission queue entries. */
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (cq_size > sq_size)
+        sq_size = cq_size;
+    rings = mmap(NULL, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQ_RING);
+    if (rings == MAP_FAILED)
+        return unavailable(tc, fd);
+    sqes = mmap(NULL, params.sq_entries * sizeof(struct io_uring_sqe),
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        munmap(rings, sq_size);
+        return unavailable(tc, fd);
+    }
+
+    ring                = MVM_calloc(1, sizeof(MVMIOUring));
+    ring->fd            = fd;
+    ring->rings         = rings;
+    ring->rings_size    = sq_size;
+    ring->sqes          = sqes;
+    ring->sqes_size     = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sq_head       = (unsigned *)(rings + params.sq_off.head);
+    ring->sq_tail       = (unsigned *)(rings + params.sq_off.tail);
+    ring->sq_mask       = (unsigned *)(rings + params.sq_off.ring_mask);
+    ring->sq_array      = (unsigned *)(rings + params.sq_off.array);
+    ring->cq_head       = (unsigned *)(rings + params.cq_off.head);
+    ring->cq_tail       = (unsigned *)(rings + params.cq_off.tail);
+    ring->cq_mask       = (unsigned *)(rings + params.cq_off.ring_mask);
+    ring->cqes          = (struct io_uring_cqe *)(rings + params.cq_off.cqes);
+    ring->max_in_flight = params.sq_entries < params.cq_entries
+        ? params.sq_entries
+        : params.cq_entries;
+    uv_mutex_init(&ring->mutex);
+    uv_cond_init(&ring->completed);
+    return ring;
+}
+
+/* Frees a ring that has nothing in flight on it. */
+static void free_ring(MVMIOUring *ring) {
+    munmap(ring->sqes, ring->sqes_size);
+    munmap(ring->rings, ring->rings_size);
+    close(ring->fd);
+    uv_cond_destroy(&ring->completed);
+    uv_mutex_destroy(&ring->mutex);
+    MVM_free(ring);
+}
+
+/* Gets the instance's io_uring, creating it if this is the first time it is
+ * wanted; NULL if we can't have one. If two threads race to create it, the
+ * loser frees the one it made. */
+static MVMIOUring * get_ring(MVMThreadContext *tc) {
+    MVMIOUring *ring = (MVMIOUring *)MVM_load(&tc->instance->io_uring);
+    if (ring || MVM_load(&tc->instance->io_uring_unavailable))
+        return ring;
+    ring = create(tc);
+    if (ring && MVM_casptr(&tc->instance->io_uring, NULL, ring) != NULL) {
+        free_ring(ring);
+        ring = (MVMIOUring *)MVM_load(&tc->instance->io_uring);
+    }
+    return ring;
+}
+
+/* Takes all the completions off the ring, filling out their operations, or
+ * freeing them if they were abandoned. Must hold the ring's mutex, and not
+ * have another thread waiting in the kernel. Returns if we took any. */
+static MVMint32 reap(MVMThreadContext *tc, MVMIOUring *ring) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    MVMint32 reaped = head != tail;
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        MVMIOUringOp *op = (MVMIOUringOp *)(uintptr_t)cqe->user_data;
+        op->result = cqe->res;
+        if (op->abandoned) {
+            MVM_io_buffer_pool_give(tc, op->buf, op->buf_size);
+            MVM_free(op);
+        }
+        else {
+            op->done = 1;
+        }
+        ring->in_flight--;
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    if (reaped)
+        uv_cond_broadcast(&ring->completed);
+    return reaped;
+}
+
+/* Submits a read or write at the current file position. Returns NULL if we
+ * have no io_uring, it is full, or the kernel would not take it, in which
+ * case the caller should do the I/O itself. We are marked blocked while we
+ * hold the ring's mutex, since the kernel may do the I/O right away. */
+static MVMIOUringOp * submit(MVMThreadContext *tc, MVMuint8 opcode, int fd, char *buf,
+                             size_t buf_size, MVMint64 bytes) {
+    MVMIOUring *ring = get_ring(tc);
+    MVMIOUringOp *op;
+    int r = -1;
+    if (!ring)
+        return NULL;
+    op           = MVM_calloc(1, sizeof(MVMIOUringOp));
+    op->buf      = buf;
+    op->buf_size = buf_size;
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&ring->mutex);
+    if (ring->in_flight < ring->max_in_flight) {
+        unsigned tail = *ring->sq_tail;
+        unsigned index = tail & *ring->sq_mask;
+        struct io_uring_sqe *sqe = &ring->sqes[index];
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+        sqe->opcode    = opcode;
+        sqe->fd        = fd;
+        sqe->off       = (__u64)-1;
+        sqe->addr      = (__u64)(uintptr_t)buf;
+        sqe->len       = (__u32)bytes;
+        sqe->user_data = (__u64)(uintptr_t)op;
+        ring->sq_array[index] = index;
+        __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+        do {
+            r = io_uring_enter(ring->fd, 1, 0, 0);
+        } while (r < 0 && errno == EINTR);
+        if (r < 1)
+            /* The kernel took nothing, so take the entry back off the ring. */
+            __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+        else
+            ring->in_flight++;
+    }
+    uv_mutex_unlock(&ring->mutex);
+    MVM_gc_mark_thread_unblocked(tc);
+    if (r < 1) {
+        MVM_free(op);
+        return NULL;
+    }
+    return op;
+}
+
+/* Submits a read of up to the specified number of bytes into the buffer,
+ * from the current file position. */
+MVMIOUringOp * MVM_io_uring_submit_read(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes) {
+    return submit(tc, IORING_OP_READ, fd, buf, buf_size, bytes);
+}
+
+/* Submits a write of the bytes in the buffer at the current file position. */
+MVMIOUringOp * MVM_io_uring_submit_write(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes) {
+    return submit(tc, IORING_OP_WRITE, fd, buf, buf_size, bytes);
+}
+
+/* Waits for an operation to complete, frees it, and returns its result. If
+ * it already completed, no system call is needed. The buffer stays with the
+ * caller. */
+MVMint64 MVM_io_uring_wait(MVMThreadContext *tc, MVMIOUringOp *op) {
+    MVMIOUring *ring = (MVMIOUring *)MVM_load(&tc->instance->io_uring);
+    MVMint64 result;
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&ring->mutex);
+    while (!op->done) {
+        int r, save_errno;
+        if (ring->kernel_waiter) {
+            uv_cond_wait(&ring->completed, &ring->mutex);
+            continue;
+        }
+        if (reap(tc, ring))
+            continue;
+        ring->kernel_waiter = 1;
+        uv_mutex_unlock(&ring->mutex);
+        r = io_uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+        save_errno = errno;
+        uv_mutex_lock(&ring->mutex);
+        ring->kernel_waiter = 0;
+        uv_cond_broadcast(&ring->completed);
+        if (r < 0 && save_errno != EINTR) {
+            uv_mutex_unlock(&ring->mutex);
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_exception_throw_adhoc(tc, "Failed to wait on io_uring: %s", strerror(save_errno));
+        }
+    }
+    uv_mutex_unlock(&ring->mutex);
+    MVM_gc_mark_thread_unblocked(tc);
+    result = op->result;
+    MVM_free(op);
+    return result;
+}
+
+/* Gives up on an operation, along with its buffer, which must be one that
+ * can be given to the I/O buffer pool (or freed). If it is still in flight,
+ * the kernel may yet be using the buffer, so it is freed whenever somebody
+ * takes the completion. This doesn't wait, so is fine to use during GC. */
+void MVM_io_uring_abandon(MVMThreadContext *tc, MVMIOUringOp *op) {
+    MVMIOUring *ring = (MVMIOUring *)MVM_load(&tc->instance->io_uring);
+    uv_mutex_lock(&ring->mutex);
+    if (op->done) {
+        MVM_io_buffer_pool_give(tc, op->buf, op->buf_size);
+        MVM_free(op);
+    }
+    else {
+        op->abandoned = 1;
+    }
+    uv_mutex_unlock(&ring->mutex);
+}
+
+/* Destroys the instance's io_uring, if it has one, at VM exit. The kernel
+ * may still be using the buffers of abandoned operations, so we wait for
+ * everything in flight first. */
+void MVM_io_uring_destroy(MVMThreadContext *tc) {
+    MVMIOUring *ring = (MVMIOUring *)MVM_load(&tc->instance->io_uring);
+    if (!ring)
+        return;
+    uv_mutex_lock(&ring->mutex);
+    while (ring->in_flight)
+        if (!reap(tc, ring) && io_uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0
+                && errno != EINTR)
+            break;
+    uv_mutex_unlock(&ring->mutex);
+    free_ring(ring);
+    MVM_store(&tc->instance->io_uring, NULL);
+}
+
+#else
+
+MVMIOUringOp * MVM_io_uring_submit_read(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes) {
+    return NULL;
+}
+MVMIOUringOp * MVM_io_uring_submit_write(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes) {
+    return NULL;
+}
+MVMint64 MVM_io_uring_wait(MVMThreadContext *tc, MVMIOUringOp *op) {
+    MVM_exception_throw_adhoc(tc, "io_uring is not supported on this platform");
+}
+void MVM_io_uring_abandon(MVMThreadContext *tc, MVMIOUringOp *op) {
+}
+void MVM_io_uring_destroy(MVMThreadContext *tc) {
+}
+
+#endif
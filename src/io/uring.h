@@ -0,0 +1,67 @@
+/* An io_uring, which synchronous file handles use to keep a read of the next
+ * chunk of a file, or a write of a full output buffer, in flight while the
+ * VM gets on with other work. It's only built on Linux, and only used if the
+ * kernel lets us have one (it may be too old, or io_uring may be disabled);
+ * callers otherwise just do plain blocking I/O. There is one ring for the
+ * whole instance, made the first time it's wanted, since a handle may be
+ * used from any thread; each handle has at most a read-ahead or a write in
+ * flight on it, so this is how many handles can have one at a time. */
+#define MVM_IO_URING_ENTRIES 64
+
+/* The most we will read ahead at a time; the largest I/O buffer pool size. */
+#define MVM_IO_URING_READ_AHEAD_MAX 262144
+
+#ifdef MVM_HAS_IO_URING
+struct MVMIOUring {
+    /* The ring's file descriptor. */
+    int fd;
+
+    /* Submission queue head, tail, mask and index array, along with the
+     * submission queue entries themselves. */
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+
+    /* Completion queue head, tail, mask and entries. */
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    /* The mapped rings and submission entries, and their sizes. */
+    void   *rings;
+    size_t  rings_size;
+    size_t  sqes_size;
+
+    /* How many operations we can have in flight, and how many are. */
+    MVMuint32 max_in_flight;
+    MVMuint32 in_flight;
+
+    /* Protects the rings and the operations. Only one thread at a time waits
+     * in the kernel for completions, and only it takes them off the ring;
+     * others wanting a completion wait on the condition variable, which is
+     * signalled whenever completions are taken. */
+    uv_mutex_t mutex;
+    uv_cond_t  completed;
+    MVMuint8   kernel_waiter;
+};
+
+/* An operation submitted to the io_uring. Once it completes, it holds the
+ * result: the number of bytes read or written, or a negated errno. If it is
+ * abandoned while in flight, its buffer is freed when it completes. */
+struct MVMIOUringOp {
+    MVMint64  result;
+    char     *buf;
+    size_t    buf_size;
+    MVMuint8  done;
+    MVMuint8  abandoned;
+};
+#endif
+
+MVMIOUringOp * MVM_io_uring_submit_read(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes);
+MVMIOUringOp * MVM_io_uring_submit_write(MVMThreadContext *tc, int fd, char *buf, size_t buf_size, MVMint64 bytes);
+MVMint64 MVM_io_uring_wait(MVMThreadContext *tc, MVMIOUringOp *op);
+void MVM_io_uring_abandon(MVMThreadContext *tc, MVMIOUringOp *op);
+void MVM_io_uring_destroy(MVMThreadContext *tc);
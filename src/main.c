@@ -88,7 +88,19 @@ The following environment variables are respected:\n\
     MVM_CROSS_THREAD_WRITE_LOG  Log unprotected cross-thread object writes to stderr\n\
     MVM_COVERAGE_LOG            Append (de-duped by default) line-by-line coverage messages to this file\n\
     MVM_COVERAGE_CONTROL        If set to 1, non-de-duping coverage started with nqp::coveragecontrol(1),\n\
-                                  if set to 2, non-de-duping coverage started right away\n"
+                                  if set to 2, non-de-duping coverage started right away\n\
+    MVM_SC_PRELOAD              Deserialize up front what the last run with this file needed,\n\
+                                  and save what this run needed to it at exit\n\
+    MVM_SC_PRELOAD_THREADS      Number of threads to do that on (0 to do it as each module loads)\n\
+    MVM_VALIDATION_CACHE        Directory to remember validated frames of bytecode files in,\n\
+                                  so later runs needn't validate them again\n\
+    MVM_MAST_CACHE_SIZE         Number of compiled MAST compilation units to keep in memory for reuse\n\
+                                  (default 0, which disables it)\n\
+    MVM_MAST_CACHE_DIR          Directory to also keep compiled MAST compilation units in\n\
+    MVM_MAST_CACHE_DIR_SIZE     Most compilation units to keep in MVM_MAST_CACHE_DIR, least recently\n\
+                                  used removed first (default 1024, 0 for no limit)\n\
+    MVM_STARTUP_TRACE           File to write wall time, allocations and GC runs of each phase of\n\
+                                  startup and of loading each compilation unit to, as JSON\n"
     TELEMEH_USAGE;
 
 static int cmp_flag(const void *key, const void *value)
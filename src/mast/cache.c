@@ -0,0 +1,320 @@
+#include "moar.h"
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+/* Header of an entry on disk, followed by the bytecode. Since anything may
+ * turn up in the directory, we only trust a file that says it holds the
+ * entry for the key we want, as written by this version of MoarVM. */
+#define DISK_ENTRY_MAGIC "MVMMASTC"
+typedef struct {
+    char      magic[8];
+    char      version[32];
+    MVMuint64 key[2];
+    MVMuint64 size;
+} DiskEntryHeader;
+
+/* An entry found on disk when trimming the directory. */
+typedef struct {
+    char   *name;
+    double  mtime;
+} DiskEntry;
+
+/* Sets up the cache of MAST compiler output. */
+void MVM_mast_cache_init(MVMThreadContext *tc, MVMuint32 max_entries, const char *dir,
+                         MVMuint32 max_disk_entries) {
+    MVMMASTCache *cache = MVM_calloc(1, sizeof(MVMMASTCache));
+    cache->max_entries      = max_entries;
+    cache->max_disk_entries = max_disk_entries;
+    if (dir) {
+        cache->dir = MVM_malloc(strlen(dir) + 1);
+        strcpy(cache->dir, dir);
+    }
+    uv_mutex_init(&cache->mutex);
+    tc->instance->mast_cache = cache;
+}
+
+/* Forms the name of the file holding an entry on disk. */
+static char * entry_file_name(MVMThreadContext *tc, MVMMASTCache *cache, MVMuint64 key[2]) {
+    size_t  len  = strlen(cache->dir) + 48;
+    char   *name = MVM_malloc(len);
+    snprintf(name, len, "%s/%016"PRIx64"%016"PRIx64".moarvm", cache->dir, key[0], key[1]);
+    return name;
+}
+
+/* Takes an entry out of the list. */
+static void unlink_entry(MVMMASTCache *cache, MVMMASTCacheEntry *entry) {
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        cache->first = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        cache->last = entry->prev;
+    cache->num_entries--;
+}
+
+/* Puts an entry at the start of the list, as the most recently used. */
+static void push_entry(MVMMASTCache *cache, MVMMASTCacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->first;
+    if (cache->first)
+        cache->first->prev = entry;
+    else
+        cache->last = entry;
+    cache->first = entry;
+    cache->num_entries++;
+}
+
+/* Adds an entry to the in-memory cache, taking ownership of the bytecode,
+ * and throwing out the least recently used entries if it's full. Call with
+ * the mutex held. */
+static void add_in_memory(MVMMASTCache *cache, MVMuint64 key[2], char *bytecode, MVMuint32 size) {
+    MVMMASTCacheEntry *entry;
+    if (!cache->max_entries) {
+        MVM_free(bytecode);
+        return;
+    }
+    while (cache->num_entries >= cache->max_entries) {
+        MVMMASTCacheEntry *evict = cache->last;
+        unlink_entry(cache, evict);
+        MVM_free(evict->bytecode);
+        MVM_free(evict);
+    }
+    entry           = MVM_malloc(sizeof(MVMMASTCacheEntry));
+    entry->key[0]   = key[0];
+    entry->key[1]   = key[1];
+    entry->bytecode = bytecode;
+    entry->size     = size;
+    push_entry(cache, entry);
+}
+
+/* Fills out the header for an entry on disk. */
+static void make_header(DiskEntryHeader *header, MVMuint64 key[2], MVMuint64 size) {
+    memset(header, 0, sizeof(DiskEntryHeader));
+    memcpy(header->magic, DISK_ENTRY_MAGIC, sizeof(header->magic));
+    strncpy(header->version, MVM_VERSION, sizeof(header->version) - 1);
+    header->key[0] = key[0];
+    header->key[1] = key[1];
+    header->size   = size;
+}
+
+/* Reads an entry from disk, returning NULL if there's none, or if the file
+ * isn't the one we want. On a hit, the file's modification time is updated,
+ * so trimming the directory throws out the least recently used entries. */
+static char * read_from_disk(MVMThreadContext *tc, MVMMASTCache *cache, MVMuint64 key[2], MVMuint32 *size) {
+    char            *name = entry_file_name(tc, cache, key);
+    FILE            *fh   = fopen(name, "rb");
+    char            *bytecode;
+    long             file_size;
+    MVMuint64        bytecode_size;
+    DiskEntryHeader  header, expected;
+    uv_fs_t          req;
+    if (!fh) {
+        MVM_free(name);
+        return NULL;
+    }
+    if (fseek(fh, 0, SEEK_END) != 0 || (file_size = ftell(fh)) < 0 || fseek(fh, 0, SEEK_SET) != 0
+            || (MVMuint64)file_size < sizeof(DiskEntryHeader) + 8
+            || (MVMuint64)file_size - sizeof(DiskEntryHeader) > (MVMuint64)UINT32_MAX) {
+        fclose(fh);
+        MVM_free(name);
+        return NULL;
+    }
+    bytecode_size = (MVMuint64)file_size - sizeof(DiskEntryHeader);
+    make_header(&expected, key, bytecode_size);
+    if (fread(&header, 1, sizeof(DiskEntryHeader), fh) != sizeof(DiskEntryHeader)
+            || memcmp(&header, &expected, sizeof(DiskEntryHeader)) != 0) {
+        fclose(fh);
+        MVM_free(name);
+        return NULL;
+    }
+    bytecode = MVM_malloc(bytecode_size);
+    if (fread(bytecode, 1, bytecode_size, fh) != bytecode_size || memcmp(bytecode, "MOARVM\r\n", 8) != 0) {
+        MVM_free(bytecode);
+        fclose(fh);
+        MVM_free(name);
+        return NULL;
+    }
+    fclose(fh);
+    uv_fs_utime(tc->loop, &req, name, (double)time(NULL), (double)time(NULL), NULL);
+    uv_fs_req_cleanup(&req);
+    MVM_free(name);
+    *size = (MVMuint32)bytecode_size;
+    return bytecode;
+}
+
+/* Orders entries on disk from least to most recently used. */
+static int cmp_disk_entry(const void *a, const void *b) {
+    double mtime_a = ((const DiskEntry *)a)->mtime;
+    double mtime_b = ((const DiskEntry *)b)->mtime;
+    return mtime_a < mtime_b ? -1 : mtime_a > mtime_b ? 1 : 0;
+}
+
+/* Checks if a file in the directory is named like an entry. */
+static MVMint32 is_entry_file_name(const char *name) {
+    size_t len = strlen(name);
+    return len == 32 + strlen(".moarvm") && strcmp(name + 32, ".moarvm") == 0;
+}
+
+/* If there are more entries on disk than we should keep, removes the least
+ * recently used ones. */
+static void trim_disk(MVMThreadContext *tc, MVMMASTCache *cache) {
+    uv_fs_t      req;
+    uv_dirent_t  dirent;
+    DiskEntry   *entries;
+    MVMuint32    num_entries = 0;
+    MVMuint32    i;
+    int          num_files;
+    if (!cache->max_disk_entries)
+        return;
+    if ((num_files = uv_fs_scandir(tc->loop, &req, cache->dir, 0, NULL)) < 0) {
+        uv_fs_req_cleanup(&req);
+        return;
+    }
+    if ((MVMuint32)num_files <= cache->max_disk_entries) {
+        uv_fs_req_cleanup(&req);
+        return;
+    }
+
+    /* Find out when each entry was last used. */
+    entries = MVM_malloc(num_files * sizeof(DiskEntry));
+    while (uv_fs_scandir_next(&req, &dirent) != UV_EOF) {
+        uv_fs_t  stat_req;
+        size_t   len;
+        char    *path;
+        if (num_entries == (MVMuint32)num_files || !is_entry_file_name(dirent.name))
+            continue;
+        len  = strlen(cache->dir) + strlen(dirent.name) + 2;
+        path = MVM_malloc(len);
+        snprintf(path, len, "%s/%s", cache->dir, dirent.name);
+        if (uv_fs_stat(tc->loop, &stat_req, path, NULL) < 0) {
+            MVM_free(path);
+        }
+        else {
+            entries[num_entries].name  = path;
+            entries[num_entries].mtime = (double)stat_req.statbuf.st_mtim.tv_sec
+                + (double)stat_req.statbuf.st_mtim.tv_nsec / 1e9;
+            num_entries++;
+        }
+        uv_fs_req_cleanup(&stat_req);
+    }
+    uv_fs_req_cleanup(&req);
+
+    /* Remove the oldest. Another process may be doing the same; failing to
+     * remove a file it already removed is fine. */
+    if (num_entries > cache->max_disk_entries) {
+        qsort(entries, num_entries, sizeof(DiskEntry), cmp_disk_entry);
+        for (i = 0; i < num_entries - cache->max_disk_entries; i++)
+            remove(entries[i].name);
+    }
+    for (i = 0; i < num_entries; i++)
+        MVM_free(entries[i].name);
+    MVM_free(entries);
+}
+
+/* Writes an entry to disk, then trims the directory if it has too many. It
+ * goes to a temporary file first, then gets renamed into place, so other
+ * processes never see a partial entry. */
+static void write_to_disk(MVMThreadContext *tc, MVMMASTCache *cache, MVMuint64 key[2], char *bytecode, MVMuint32 size) {
+    char            *name     = entry_file_name(tc, cache, key);
+    size_t           tmp_len  = strlen(name) + 32;
+    char            *tmp_name = MVM_malloc(tmp_len);
+    FILE            *fh;
+    DiskEntryHeader  header;
+    make_header(&header, key, size);
+    snprintf(tmp_name, tmp_len, "%s.%d.%p.tmp", name, (int)getpid(), (void *)tc);
+    if ((fh = fopen(tmp_name, "wb"))) {
+        int ok = fwrite(&header, 1, sizeof(DiskEntryHeader), fh) == sizeof(DiskEntryHeader)
+            && fwrite(bytecode, 1, size, fh) == size;
+        if (fclose(fh) != 0)
+            ok = 0;
+        if (!ok || rename(tmp_name, name) != 0)
+            remove(tmp_name);
+        else
+            trim_disk(tc, cache);
+    }
+    MVM_free(tmp_name);
+    MVM_free(name);
+}
+
+/* Looks for bytecode compiled from MAST with the given hash. If found,
+ * returns a copy of it, for the caller to own, and sets size. Otherwise,
+ * returns NULL. */
+char * MVM_mast_cache_get(MVMThreadContext *tc, MVMuint64 key[2], MVMuint32 *size) {
+    MVMMASTCache      *cache = tc->instance->mast_cache;
+    MVMMASTCacheEntry *entry;
+    char              *bytecode = NULL;
+    if (!cache)
+        return NULL;
+
+    uv_mutex_lock(&cache->mutex);
+    for (entry = cache->first; entry; entry = entry->next) {
+        if (entry->key[0] == key[0] && entry->key[1] == key[1]) {
+            /* Move it to the front, as the most recently used. */
+            unlink_entry(cache, entry);
+            push_entry(cache, entry);
+            bytecode = MVM_malloc(entry->size);
+            memcpy(bytecode, entry->bytecode, entry->size);
+            *size = entry->size;
+            break;
+        }
+    }
+    uv_mutex_unlock(&cache->mutex);
+
+    /* If it's not in memory, try the disk, and keep it in memory if we find
+     * it there. */
+    if (!bytecode && cache->dir) {
+        bytecode = read_from_disk(tc, cache, key, size);
+        if (bytecode) {
+            char *copy = MVM_malloc(*size);
+            memcpy(copy, bytecode, *size);
+            uv_mutex_lock(&cache->mutex);
+            add_in_memory(cache, key, copy, *size);
+            uv_mutex_unlock(&cache->mutex);
+        }
+    }
+
+    return bytecode;
+}
+
+/* Adds bytecode compiled from MAST with the given hash to the cache. The
+ * caller keeps ownership of the bytecode. */
+void MVM_mast_cache_add(MVMThreadContext *tc, MVMuint64 key[2], char *bytecode, MVMuint32 size) {
+    MVMMASTCache *cache = tc->instance->mast_cache;
+    if (!cache)
+        return;
+    if (cache->max_entries) {
+        char *copy = MVM_malloc(size);
+        memcpy(copy, bytecode, size);
+        uv_mutex_lock(&cache->mutex);
+        add_in_memory(cache, key, copy, size);
+        uv_mutex_unlock(&cache->mutex);
+    }
+    if (cache->dir)
+        write_to_disk(tc, cache, key, bytecode, size);
+}
+
+/* Frees the cache and everything in it. */
+void MVM_mast_cache_destroy(MVMThreadContext *tc) {
+    MVMMASTCache      *cache = tc->instance->mast_cache;
+    MVMMASTCacheEntry *entry;
+    if (!cache)
+        return;
+    entry = cache->first;
+    while (entry) {
+        MVMMASTCacheEntry *next = entry->next;
+        MVM_free(entry->bytecode);
+        MVM_free(entry);
+        entry = next;
+    }
+    uv_mutex_destroy(&cache->mutex);
+    MVM_free(cache->dir);
+    MVM_free(cache);
+    tc->instance->mast_cache = NULL;
+}
@@ -0,0 +1,42 @@
+/* An entry in the in-process cache of MAST compiler output. */
+struct MVMMASTCacheEntry {
+    /* Hash of the MAST the bytecode was compiled from. */
+    MVMuint64 key[2];
+
+    /* The bytecode and its size. */
+    char      *bytecode;
+    MVMuint32  size;
+
+    /* Neighbours in the list of entries, most recently used first. */
+    MVMMASTCacheEntry *prev;
+    MVMMASTCacheEntry *next;
+};
+
+/* Cache of MAST compiler output, keyed by a hash of the MAST, so that
+ * compiling the same thing again (such as an EVAL of the same code) can go
+ * straight to loading the bytecode. Entries are kept in memory, up to a
+ * limit, least recently used first out, and optionally also on disk, where
+ * other processes can find them. */
+struct MVMMASTCache {
+    /* List of entries, most recently used first, and how many there are. */
+    MVMMASTCacheEntry *first;
+    MVMMASTCacheEntry *last;
+    MVMuint32          num_entries;
+
+    /* Most entries to keep in memory. */
+    MVMuint32 max_entries;
+
+    /* Directory to keep entries on disk in, or NULL, and the most entries
+     * to keep there (0 for no limit). */
+    char      *dir;
+    MVMuint32  max_disk_entries;
+
+    /* Mutex protecting the list. */
+    uv_mutex_t mutex;
+};
+
+void MVM_mast_cache_init(MVMThreadContext *tc, MVMuint32 max_entries, const char *dir,
+                         MVMuint32 max_disk_entries);
+char * MVM_mast_cache_get(MVMThreadContext *tc, MVMuint64 key[2], MVMuint32 *size);
+void MVM_mast_cache_add(MVMThreadContext *tc, MVMuint64 key[2], char *bytecode, MVMuint32 size);
+void MVM_mast_cache_destroy(MVMThreadContext *tc);
@@ -1611,3 +1611,314 @@ char * MVM_mast_compile(VM, MASTNode *node, MASTNodeTypes *types, unsigned int *
     *size = bytecode_size;
     return bytecode;
 }
+
+/* State for hashing a MAST tree. */
+typedef struct {
+    MVMuint64 h1, h2;
+} MASTHash;
+
+/* The index we give each label, in the order we meet them. */
+typedef struct {
+    MASTNode       *label;
+    MVMuint64       ordinal;
+    UT_hash_handle  hash_handle;
+} LabelOrdinal;
+
+/* Describes the state for hashing a compilation unit. */
+typedef struct {
+    MASTNodeTypes *types;
+    MAST_CompUnit *cu;
+    MASTHash       hash;
+    LabelOrdinal  *labels;
+    MVMuint64      num_labels;
+    int            uncacheable;
+} HashState;
+
+/* Mixes a value into both halves of a hash. */
+static void mix(HashState *hs, MVMuint64 value) {
+    hs->hash.h1 = (hs->hash.h1 ^ value) * 0x9E3779B97F4A7C15ULL;
+    hs->hash.h1 ^= hs->hash.h1 >> 31;
+    hs->hash.h2 = (hs->hash.h2 + value) * 0xC2B2AE3D27D4EB4FULL;
+    hs->hash.h2 ^= hs->hash.h2 >> 29;
+}
+
+/* Hashes a string by its graphemes. Synthetics are numbered differently in
+ * each process, so we hash the codepoints they stand for instead. */
+static void hash_string(VM, HashState *hs, VMSTR *s) {
+    MVMGraphemeIter gi;
+    if (VM_STRING_IS_NULL(s)) {
+        mix(hs, 0xFFFFFFFFFFFFFFFFULL);
+        return;
+    }
+    mix(hs, MVM_string_graphs(tc, s));
+    MVM_string_gi_init(tc, &gi, s);
+    while (MVM_string_gi_has_more(tc, &gi)) {
+        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
+        if (g >= 0) {
+            mix(hs, (MVMuint64)g);
+        }
+        else {
+            MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+            MVMint32 i;
+            mix(hs, 0x100000000ULL | (MVMuint32)synth->num_codes);
+            for (i = 0; i < synth->num_codes; i++)
+                mix(hs, (MVMuint64)synth->codes[i]);
+        }
+    }
+}
+
+/* Hashes a reference to a frame by its index, as get_frame_index finds it. */
+static void hash_frame_ref(VM, HashState *hs, MASTNode *frame) {
+    if (VM_OBJ_IS_NULL(frame) || !ISTYPE(vm, frame, hs->types->Frame)) {
+        mix(hs, 0xFFFFFFFFULL);
+    }
+    else if (((MAST_Frame *)frame)->flags & FRAME_FLAG_HAS_INDEX) {
+        mix(hs, (MVMuint16)((MAST_Frame *)frame)->index);
+    }
+    else {
+        unsigned int num_frames = ELEMS(vm, hs->cu->frames);
+        unsigned int i;
+        for (i = 0; i < num_frames; i++)
+            if (ATPOS(vm, hs->cu->frames, i) == frame)
+                break;
+        mix(hs, i < num_frames ? i : 0xFFFFFFFFULL);
+    }
+}
+
+/* Hashes a type used for a local or lexical by what type_to_local_type
+ * looks at. */
+static void hash_local_type(VM, HashState *hs, MASTNode *type) {
+    const MVMStorageSpec *ss;
+    if (VM_OBJ_IS_NULL(type)) {
+        mix(hs, 0);
+        return;
+    }
+    ss = REPR(type)->get_storage_spec(vm, STABLE(type));
+    mix(hs, 1 | (MVMuint64)ss->inlineable << 1 | (MVMuint64)ss->boxed_primitive << 8
+        | (MVMuint64)ss->bits << 16 | (MVMuint64)ss->is_unsigned << 32);
+}
+
+static void hash_node(VM, HashState *hs, MASTNode *node);
+
+/* Hashes a list of MAST nodes. */
+static void hash_node_list(VM, HashState *hs, MASTNode *list) {
+    unsigned int num, i;
+    if (VM_OBJ_IS_NULL(list)) {
+        mix(hs, 0xFFFFFFFFULL);
+        return;
+    }
+    num = ELEMS(vm, list);
+    mix(hs, num);
+    for (i = 0; i < num; i++)
+        hash_node(vm, hs, ATPOS(vm, list, i));
+}
+
+/* Hashes a MAST node found in an instruction list or as an operand. */
+static void hash_node(VM, HashState *hs, MASTNode *node) {
+    MASTNodeTypes *types = hs->types;
+    if (VM_OBJ_IS_NULL(node)) {
+        mix(hs, 0);
+    }
+    else if (ISTYPE(vm, node, types->Op)) {
+        MAST_Op *o = GET_Op(node);
+        mix(hs, 1);
+        mix(hs, (MVMuint64)o->op);
+        hash_node_list(vm, hs, o->operands);
+    }
+    else if (ISTYPE(vm, node, types->ExtOp)) {
+        MAST_ExtOp *o = GET_ExtOp(node);
+        mix(hs, 2);
+        mix(hs, (MVMuint64)o->op);
+        hash_string(vm, hs, o->name);
+        hash_node_list(vm, hs, o->operands);
+    }
+    else if (ISTYPE(vm, node, types->SVal)) {
+        mix(hs, 3);
+        hash_string(vm, hs, GET_SVal(node)->value);
+    }
+    else if (ISTYPE(vm, node, types->IVal)) {
+        mix(hs, 4);
+        mix(hs, (MVMuint64)GET_IVal(node)->value);
+    }
+    else if (ISTYPE(vm, node, types->NVal)) {
+        MVMuint64 bits;
+        memcpy(&bits, &(GET_NVal(node)->value), sizeof(bits));
+        mix(hs, 5);
+        mix(hs, bits);
+    }
+    else if (ISTYPE(vm, node, types->Label)) {
+        /* Labels are told apart by identity, so number them. */
+        LabelOrdinal *entry;
+        HASH_FIND(hash_handle, hs->labels, &node, sizeof(MASTNode *), entry);
+        if (!entry) {
+            entry          = MVM_malloc(sizeof(LabelOrdinal));
+            entry->label   = node;
+            entry->ordinal = hs->num_labels++;
+            HASH_ADD_KEYPTR(hash_handle, hs->labels, &entry->label, sizeof(MASTNode *), entry);
+        }
+        mix(hs, 6);
+        mix(hs, entry->ordinal);
+    }
+    else if (ISTYPE(vm, node, types->Local)) {
+        mix(hs, 7);
+        mix(hs, (MVMuint64)GET_Local(node)->index);
+    }
+    else if (ISTYPE(vm, node, types->Lexical)) {
+        mix(hs, 8);
+        mix(hs, (MVMuint64)GET_Lexical(node)->index);
+        mix(hs, (MVMuint64)GET_Lexical(node)->frames_out);
+    }
+    else if (ISTYPE(vm, node, types->Call)) {
+        MAST_Call    *c = GET_Call(node);
+        unsigned int  num_flags, i;
+        mix(hs, 9);
+        mix(hs, (MVMuint64)c->op);
+        hash_node(vm, hs, c->target);
+        num_flags = ELEMS(vm, c->flags);
+        mix(hs, num_flags);
+        for (i = 0; i < num_flags; i++)
+            mix(hs, (MVMuint64)ATPOS_I_C(vm, c->flags, i));
+        hash_node_list(vm, hs, c->args);
+        hash_node(vm, hs, c->result);
+    }
+    else if (ISTYPE(vm, node, types->Annotated)) {
+        MAST_Annotated *a = GET_Annotated(node);
+        mix(hs, 10);
+        hash_string(vm, hs, a->file);
+        mix(hs, (MVMuint64)a->line);
+        hash_node_list(vm, hs, a->instructions);
+    }
+    else if (ISTYPE(vm, node, types->HandlerScope)) {
+        MAST_HandlerScope *h = GET_HandlerScope(node);
+        mix(hs, 11);
+        hash_node_list(vm, hs, h->instructions);
+        mix(hs, (MVMuint64)h->category_mask);
+        mix(hs, (MVMuint64)h->action);
+        hash_node(vm, hs, h->goto_label);
+        hash_node(vm, hs, h->block_local);
+        hash_node(vm, hs, h->label_local);
+    }
+    else if (ISTYPE(vm, node, types->Frame)) {
+        mix(hs, 12);
+        hash_frame_ref(vm, hs, node);
+    }
+    else {
+        /* Not something the compiler would take; leave it to the compiler
+         * to complain. */
+        hs->uncacheable = 1;
+    }
+}
+
+/* Hashes everything compile_frame reads from a frame. */
+static void hash_frame(VM, HashState *hs, MASTNode *node) {
+    MAST_Frame   *f = GET_Frame(node);
+    unsigned int  num, i;
+    if (!ISTYPE(vm, node, hs->types->Frame)) {
+        hs->uncacheable = 1;
+        return;
+    }
+    hash_string(vm, hs, f->cuuid);
+    hash_string(vm, hs, f->name);
+    num = ELEMS(vm, f->local_types);
+    mix(hs, num);
+    for (i = 0; i < num; i++)
+        hash_local_type(vm, hs, ATPOS(vm, f->local_types, i));
+    num = ELEMS(vm, f->lexical_types);
+    mix(hs, num);
+    for (i = 0; i < num; i++)
+        hash_local_type(vm, hs, ATPOS(vm, f->lexical_types, i));
+    num = ELEMS(vm, f->lexical_names);
+    mix(hs, num);
+    for (i = 0; i < num; i++)
+        hash_string(vm, hs, ATPOS_S_C(vm, f->lexical_names, i));
+    hash_frame_ref(vm, hs, f->outer);
+    mix(hs, (MVMuint64)f->flags);
+    mix(hs, (MVMuint64)f->index);
+    mix(hs, (MVMuint64)f->code_obj_sc_dep_idx);
+    mix(hs, (MVMuint64)f->code_obj_sc_idx);
+    if (f->flags & FRAME_FLAG_HAS_SLV) {
+        num = ELEMS(vm, f->static_lex_values);
+        mix(hs, num);
+        for (i = 0; i < num; i++)
+            mix(hs, (MVMuint64)ATPOS_I(vm, f->static_lex_values, i));
+    }
+    hash_node_list(vm, hs, f->instructions);
+}
+
+/* Computes a 128-bit hash of everything MVM_mast_compile would read to
+ * produce its output: the MAST tree, and any serialized data waiting to be
+ * written out with it. Two trees with the same hash compile to the same
+ * bytecode. Returns zero if the tree holds something the compiler would
+ * reject, in which case there's no point looking for it in a cache. Doesn't
+ * allocate anything the GC knows about. */
+int MVM_mast_hash(VM, MASTNode *node, MASTNodeTypes *types, MVMuint64 hash[2]) {
+    HashState     hs;
+    MAST_CompUnit *cu;
+    const char    *version = MVM_VERSION;
+    unsigned int   num, i;
+
+    if (!ISTYPE(vm, node, types->CompUnit))
+        return 0;
+    cu = GET_CompUnit(node);
+
+    hs.types       = types;
+    hs.cu          = cu;
+    hs.hash.h1     = 0;
+    hs.hash.h2     = 0;
+    hs.labels      = NULL;
+    hs.num_labels  = 0;
+    hs.uncacheable = 0;
+
+    /* Output differs between bytecode and VM versions. */
+    mix(&hs, BYTECODE_VERSION);
+    while (*version)
+        mix(&hs, (MVMuint8)*version++);
+
+    hash_string(vm, &hs, cu->hll);
+    num = ELEMS(vm, cu->sc_handles);
+    mix(&hs, num);
+    for (i = 0; i < num; i++)
+        hash_string(vm, &hs, ATPOS_S_C(vm, cu->sc_handles, i));
+    num = ELEMS(vm, cu->extop_names);
+    mix(&hs, num);
+    for (i = 0; i < num; i++) {
+        MASTNode *sig_array = ATPOS(vm, cu->extop_sigs, i);
+        unsigned int num_operands, j;
+        hash_string(vm, &hs, ATPOS_S_C(vm, cu->extop_names, i));
+        num_operands = VM_OBJ_IS_NULL(sig_array) ? 0 : ELEMS(vm, sig_array);
+        mix(&hs, num_operands);
+        for (j = 0; j < num_operands; j++)
+            mix(&hs, (MVMuint64)ATPOS_I(vm, sig_array, j));
+    }
+    num = ELEMS(vm, cu->frames);
+    mix(&hs, num);
+    for (i = 0; i < num && !hs.uncacheable; i++)
+        hash_frame(vm, &hs, ATPOS(vm, cu->frames, i));
+    hash_frame_ref(vm, &hs, cu->main_frame);
+    hash_frame_ref(vm, &hs, cu->load_frame);
+    hash_frame_ref(vm, &hs, cu->deserialize_frame);
+
+    /* Serialized data and its strings go into the output too. */
+    if (vm->serialized) {
+        MVMuint32 j;
+        mix(&hs, vm->serialized_size);
+        for (j = 0; j + 8 <= (MVMuint32)vm->serialized_size; j += 8) {
+            MVMuint64 word;
+            memcpy(&word, vm->serialized + j, 8);
+            mix(&hs, word);
+        }
+        for (; j < (MVMuint32)vm->serialized_size; j++)
+            mix(&hs, (MVMuint8)vm->serialized[j]);
+    }
+    if (vm->serialized_string_heap) {
+        num = ELEMS(vm, vm->serialized_string_heap);
+        mix(&hs, num);
+        for (i = 1; i < num; i++)
+            hash_string(vm, &hs, ATPOS_S(vm, vm->serialized_string_heap, i));
+    }
+
+    MVM_HASH_DESTROY(hash_handle, LabelOrdinal, hs.labels);
+    hash[0] = hs.hash.h1;
+    hash[1] = hs.hash.h2;
+    return !hs.uncacheable;
+}
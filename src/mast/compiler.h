@@ -1,2 +1,4 @@
 char * MVM_mast_compile(MVMThreadContext *tc, MVMObject *node, MASTNodeTypes *types,
     unsigned int *size);
+int MVM_mast_hash(MVMThreadContext *tc, MVMObject *node, MASTNodeTypes *types,
+    MVMuint64 hash[2]);
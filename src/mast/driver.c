@@ -40,11 +40,30 @@ void MVM_mast_to_cu(MVMThreadContext *tc, MVMObject *mast, MVMObject *types,
 
         /* Turn the MAST tree into bytecode. Switch to gen2 GC allocation to be
          * sure nothing moves, though we'd really rather not have compiler
-         * temporaries live longer. */
-        unsigned int size;
-        char *bytecode;
+         * temporaries live longer. If we compiled the same MAST before, we
+         * can take the bytecode from the cache instead; then we consume any
+         * serialized data, as compiling would. */
+        MVMuint32 size;
+        MVMuint64 key[2];
+        int cacheable;
+        char *bytecode = NULL;
         MVM_gc_allocate_gen2_default_set(tc);
-        bytecode = MVM_mast_compile(tc, mast, mnt, &size);
+        cacheable = tc->instance->mast_cache && MVM_mast_hash(tc, mast, mnt, key);
+        if (cacheable)
+            bytecode = MVM_mast_cache_get(tc, key, &size);
+        if (bytecode) {
+            MVM_free(tc->serialized);
+            tc->serialized = NULL;
+            tc->serialized_size = 0;
+            tc->serialized_string_heap = NULL;
+        }
+        else {
+            unsigned int compiled_size;
+            bytecode = MVM_mast_compile(tc, mast, mnt, &compiled_size);
+            size = compiled_size;
+            if (cacheable)
+                MVM_mast_cache_add(tc, key, bytecode, size);
+        }
         MVM_free(mnt);
         MVM_gc_allocate_gen2_default_clear(tc);
 
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include <platform/threads.h>
+#include <platform/sys.h>
 
 #if defined(_MSC_VER)
 #define snprintf _snprintf
@@ -78,8 +79,14 @@ MVMInstance * MVM_vm_create_instance(void) {
          *spesh_osr_disable, *spesh_limit, *spesh_blocking;
     char *jit_log, *jit_expr_disable, *jit_disable, *jit_bytecode_dir, *jit_last_frame, *jit_last_bb;
     char *dynvar_log;
+    char *sc_preload, *sc_preload_threads, *validation_cache;
+    char *mast_cache_size, *mast_cache_dir, *mast_cache_dir_size;
+    char *startup_trace;
     int init_stat;
 
+    /* Note when we started, in case we're tracing startup. */
+    MVMuint64 start_time = uv_hrtime();
+
     /* Set up instance data structure. */
     instance = MVM_calloc(1, sizeof(MVMInstance));
 
@@ -154,8 +161,10 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up main thread's last_payload. */
     instance->main_thread->last_payload = instance->VMNull;
 
-    /* Initialize event loop thread starting mutex. */
+    /* Initialize event loop thread starting mutex, and the event loops that
+     * async work will be spread over. */
     init_mutex(instance->mutex_event_loop_start, "event loop thread start");
+    MVM_io_eventloop_init(instance, getenv("MVM_EVENT_LOOPS"));
 
     /* Create main thread object, and also make it the start of the all threads
      * linked list. Set up the mutex to protect it. */
@@ -184,6 +193,13 @@ MVMInstance * MVM_vm_create_instance(void) {
     instance->callsite_interns = MVM_calloc(1, sizeof(MVMCallsiteInterns));
     init_mutex(instance->mutex_callsite_interns, "callsite interns");
 
+    /* Set up method dispatch tables. */
+    instance->method_tables = MVM_calloc(MVM_METHOD_TABLE_BUCKETS, sizeof(MVMMethodTable *));
+    init_mutex(instance->mutex_method_tables, "method dispatch tables");
+
+    /* Set up the table of shared bytecode file mappings. */
+    init_mutex(instance->mutex_cu_mappings, "compunit mappings");
+
     /* There's some callsites we statically use all over the place. Intern
      * them, so that spesh may end up optimizing more "internal" stuff. */
     MVM_callsite_initialize_common(instance->main_thread);
@@ -346,9 +362,58 @@ MVMInstance * MVM_vm_create_instance(void) {
     MVM_spesh_worker_setup(instance->main_thread);
     MVM_spesh_log_initialize_thread(instance->main_thread, 1);
 
+    /* Should we deserialize the working set of an earlier run up front, and
+     * save the working set of this run? By default, up to 4 helper threads
+     * do the preloading. */
+    sc_preload = getenv("MVM_SC_PRELOAD");
+    if (sc_preload && sc_preload[0]) {
+        sc_preload_threads = getenv("MVM_SC_PRELOAD_THREADS");
+        if (sc_preload_threads && sc_preload_threads[0]) {
+            instance->sc_preload_threads = atoi(sc_preload_threads);
+        }
+        else {
+            MVMuint32 cpus = MVM_platform_cpu_count();
+            instance->sc_preload_threads = cpus > 5 ? 4 : cpus > 1 ? cpus - 1 : 0;
+        }
+        MVM_serialization_preload_init(instance->main_thread, sc_preload);
+    }
+
+    /* Should we remember which frames of each bytecode file passed
+     * validation, and skip validating them again? */
+    validation_cache = getenv("MVM_VALIDATION_CACHE");
+    if (validation_cache && validation_cache[0])
+        MVM_validation_cache_init(instance->main_thread, validation_cache);
+
+    /* Set up the cache of MAST compiler output, if asked for. Compilers that
+     * make every compilation unit unique (as NQP does, putting a counter in
+     * its IDs) would never get a hit, so it's off by default. On disk, we
+     * keep up to 1024 entries unless told otherwise. */
+    mast_cache_size     = getenv("MVM_MAST_CACHE_SIZE");
+    mast_cache_dir      = getenv("MVM_MAST_CACHE_DIR");
+    mast_cache_dir_size = getenv("MVM_MAST_CACHE_DIR_SIZE");
+    if (mast_cache_dir && !mast_cache_dir[0])
+        mast_cache_dir = NULL;
+    {
+        MVMuint32 max_entries = mast_cache_size && mast_cache_size[0]
+            ? (MVMuint32)atoi(mast_cache_size)
+            : 0;
+        MVMuint32 max_disk_entries = mast_cache_dir_size && mast_cache_dir_size[0]
+            ? (MVMuint32)atoi(mast_cache_dir_size)
+            : 1024;
+        if (max_entries || mast_cache_dir)
+            MVM_mast_cache_init(instance->main_thread, max_entries, mast_cache_dir,
+                max_disk_entries);
+    }
+
+    /* Should we trace where startup time goes? */
+    startup_trace = getenv("MVM_STARTUP_TRACE");
+    if (startup_trace && startup_trace[0])
+        MVM_startup_trace_init(instance->main_thread, startup_trace, start_time);
+
     /* Back to nursery allocation, now we're set up. */
     MVM_gc_allocate_gen2_default_clear(instance->main_thread);
 
+    MVM_startup_trace_stop(instance->main_thread, MVM_STARTUP_TRACE_CREATE_INSTANCE);
     return instance;
 }
 
@@ -391,9 +456,13 @@ void MVM_vm_run_file(MVMInstance *instance, const char *filename) {
          * code. */
         if (cu->body.deserialize_frame) {
             MVMint8 spesh_enabled_orig = tc->instance->spesh_enabled;
+            MVMint32 trace_phase = tc->instance->startup_trace
+                ? MVM_startup_trace_start(tc, "run deserialize frame", MVM_startup_trace_cu_name(tc, cu))
+                : 0;
             tc->instance->spesh_enabled = 0;
             MVM_interp_run(tc, toplevel_initial_invoke, cu->body.deserialize_frame);
             tc->instance->spesh_enabled = spesh_enabled_orig;
+            MVM_startup_trace_stop(tc, trace_phase);
         }
     });
 
@@ -435,6 +504,12 @@ void MVM_vm_exit(MVMInstance *instance) {
     MVM_thread_join_foreground(instance->main_thread);
     MVM_io_flush_standard_handles(instance->main_thread);
 
+    /* Save the working set of serialization contexts and which frames were
+     * validated, and write the startup trace, if asked. */
+    MVM_serialization_preload_save(instance->main_thread);
+    MVM_validation_cache_save(instance->main_thread);
+    MVM_startup_trace_write(instance->main_thread);
+
     /* Close any spesh or jit log. */
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
@@ -455,7 +530,7 @@ static void cleanup_callsite_interns(MVMInstance *instance) {
     int i;
 
     for (i = 0; i < MVM_INTERN_ARITY_LIMIT; i++) {
-        int callsite_count = instance->callsite_interns->num_by_arity[i];
+        int callsite_count = (int)instance->callsite_interns->num_by_arity[i];
         int j;
 
         if (callsite_count) {
@@ -471,7 +546,9 @@ static void cleanup_callsite_interns(MVMInstance *instance) {
                 MVM_callsite_destroy(callsite);
             }
 
-            MVM_free(callsites);
+            MVM_fixed_size_free(instance->main_thread, instance->fsa,
+                instance->callsite_interns->alloc_by_arity[i] * sizeof(MVMCallsite *),
+                callsites);
         }
     }
     MVM_free(instance->callsite_interns);
@@ -485,6 +562,12 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_thread_join_foreground(instance->main_thread);
     MVM_io_flush_standard_handles(instance->main_thread);
 
+    /* Save the working set of serialization contexts and which frames were
+     * validated, and write the startup trace, if asked. */
+    MVM_serialization_preload_save(instance->main_thread);
+    MVM_validation_cache_save(instance->main_thread);
+    MVM_startup_trace_write(instance->main_thread);
+
     /* Run the GC global destruction phase. After this,
      * no 6model object pointers should be accessed. */
     MVM_gc_global_destruction(instance->main_thread);
@@ -525,11 +608,19 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_sc_weakhash);
     MVM_HASH_DESTROY(hash_handle, MVMSerializationContextBody, instance->sc_weakhash);
     MVM_free(instance->all_scs);
+    MVM_serialization_preload_destroy(instance->main_thread);
+    MVM_validation_cache_destroy(instance->main_thread);
 
     /* Clean up Hash of filenames of compunits loaded from disk. */
     uv_mutex_destroy(&instance->mutex_loaded_compunits);
     MVM_HASH_DESTROY(hash_handle, MVMLoadedCompUnitName, instance->loaded_compunits);
 
+    /* Clean up cache of MAST compiler output. */
+    MVM_mast_cache_destroy(instance->main_thread);
+
+    /* Clean up startup trace. */
+    MVM_startup_trace_destroy(instance->main_thread);
+
     /* Clean up Container registry. */
     uv_mutex_destroy(&instance->mutex_container_registry);
     MVM_HASH_DESTROY(hash_handle, MVMContainerRegistry, instance->container_registry);
@@ -550,6 +641,15 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_callsite_interns);
     cleanup_callsite_interns(instance);
 
+    /* Clean up method dispatch tables. */
+    uv_mutex_destroy(&instance->mutex_method_tables);
+    MVM_6model_method_table_destroy_all(instance->main_thread);
+
+    /* Clean up the bytecode file mappings; global destruction freed all the
+     * compilation units and strings using them, so there should be none. */
+    uv_mutex_destroy(&instance->mutex_cu_mappings);
+    MVM_free(instance->cu_mappings);
+
     /* Release this interpreter's hold on Unicode database */
     MVM_unicode_release(instance->main_thread);
 
@@ -583,8 +683,12 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_free(instance->int_const_cache);
     MVM_free(instance->int_to_str_cache);
 
-    /* Clean up event loop starting mutex. */
+    /* Clean up event loop starting mutex and event loop state. */
     uv_mutex_destroy(&instance->mutex_event_loop_start);
+    MVM_io_eventloop_destroy(instance);
+
+    /* Wait for anything still in flight on the io_uring, and free it. */
+    MVM_io_uring_destroy(instance->main_thread);
 
     /* Destroy main thread contexts and thread list mutex. */
     MVM_tc_destroy(instance->main_thread);
@@ -173,8 +173,11 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "strings/unicode.h"
 #include "strings/latin1.h"
 #include "strings/windows1252.h"
+#include "6model/methodtable.h"
 #include "io/io.h"
 #include "io/eventloop.h"
+#include "io/bufferpool.h"
+#include "io/uring.h"
 #include "io/syncfile.h"
 #include "io/syncsocket.h"
 #include "io/fileops.h"
@@ -187,6 +190,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "io/asyncsocketudp.h"
 #include "math/bigintops.h"
 #include "mast/driver.h"
+#include "mast/cache.h"
 #include "core/intcache.h"
 #include "core/fixedsizealloc.h"
 #include "jit/graph.h"
@@ -201,6 +205,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "profiler/profile.h"
 #include "profiler/heapsnapshot.h"
 #include "profiler/telemeh.h"
+#include "profiler/startup.h"
 #include "instrument/crossthreadwrite.h"
 #include "instrument/line_coverage.h"
 
@@ -0,0 +1,37 @@
+#include "moar.h"
+#include "platform/io.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+/* Size of the buffer we copy through where there is no sendfile. */
+#define SENDFILE_BUFFER_SIZE 65536
+
+/* Sends up to length bytes, starting at offset, from the file in_fd to
+ * out_fd, leaving the file position of in_fd alone. Returns the number of
+ * bytes sent, which may be fewer than asked for, 0 if the file ended, or -1
+ * with errno set (which will be EAGAIN if out_fd is non-blocking and full).
+ * On Linux the data never leaves the kernel; elsewhere, it is copied through
+ * a buffer. */
+MVMint64 MVM_platform_sendfile(int out_fd, int in_fd, MVMint64 offset, MVMint64 length) {
+#ifdef __linux__
+    off_t off = (off_t)offset;
+    /* Linux sends at most this much per call anyway. */
+    if (length > 0x7ffff000)
+        length = 0x7ffff000;
+    return sendfile(out_fd, in_fd, &off, (size_t)length);
+#else
+    char buf[SENDFILE_BUFFER_SIZE];
+    ssize_t got;
+    if (length > SENDFILE_BUFFER_SIZE)
+        length = SENDFILE_BUFFER_SIZE;
+    got = pread(in_fd, buf, (size_t)length, (off_t)offset);
+    if (got <= 0)
+        return got;
+    return write(out_fd, buf, (size_t)got);
+#endif
+}
@@ -75,3 +75,16 @@ int MVM_platform_unmap_file(void *block, void *handle, size_t size)
     (void)handle;
     return munmap(block, size) == 0;
 }
+
+/* Hints that a mapping will be read sequentially, so the kernel can read
+ * ahead aggressively. */
+int MVM_platform_advise_sequential(void *block, size_t size)
+{
+#ifdef MADV_SEQUENTIAL
+    return madvise(block, size, MADV_SEQUENTIAL) == 0;
+#else
+    (void)block;
+    (void)size;
+    return 1;
+#endif
+}
@@ -79,3 +79,10 @@ int MVM_platform_unmap_file(void *block, void *handle, size_t size) {
     (void)size;
     return unmapped && closed;
 }
+
+int MVM_platform_advise_sequential(void *block, size_t size) {
+    /* There is no equivalent hint for a mapped view. */
+    (void)block;
+    (void)size;
+    return 1;
+}
@@ -360,6 +360,8 @@ static void process_workitems(MVMThreadContext *tc, MVMHeapSnapshotState *ss) {
 
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
                     (MVMCollectable *)st->method_cache, "Method cache");
+                MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
+                    (MVMCollectable *)st->method_table_cache, "Method dispatch table cache");
 
                 for (i = 0; i < st->type_check_cache_length; i++)
                     MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
@@ -0,0 +1,227 @@
+#include "moar.h"
+
+/* Takes a reading of the counters for the current thread. Objects the GC
+ * copied into tospace are not counted in nursery_allocated_bytes, so the
+ * difference between two readings is what the thread itself allocated. */
+static void read_counters(MVMThreadContext *tc, MVMStartupTraceCounters *counters) {
+    counters->time          = uv_hrtime();
+    counters->nursery_bytes = tc->nursery_allocated_bytes
+        + ((char *)tc->nursery_alloc - (char *)tc->nursery_tospace);
+    counters->gen2_bytes    = tc->gen2_allocated_bytes;
+    counters->gc_runs       = MVM_load(&tc->instance->gc_seq_number);
+}
+
+/* Adds the difference between two readings to a total. */
+static void add_counters(MVMStartupTraceCounters *total, MVMStartupTraceCounters *from,
+                         MVMStartupTraceCounters *to) {
+    total->time          += to->time - from->time;
+    total->nursery_bytes += to->nursery_bytes - from->nursery_bytes;
+    total->gen2_bytes    += to->gen2_bytes - from->gen2_bytes;
+    total->gc_runs       += to->gc_runs - from->gc_runs;
+}
+
+/* Turns on startup tracing, to be written to the specified file. Creating
+ * the instance started at the specified time, and is the first phase. */
+void MVM_startup_trace_init(MVMThreadContext *tc, const char *filename, MVMuint64 start_time) {
+    MVMStartupTrace      *trace = MVM_calloc(1, sizeof(MVMStartupTrace));
+    MVMStartupTracePhase *phase;
+    trace->filename   = MVM_malloc(strlen(filename) + 1);
+    strcpy(trace->filename, filename);
+    trace->start_time = start_time;
+    MVM_VECTOR_INIT(trace->phases, 64);
+    uv_mutex_init(&trace->mutex);
+
+    /* Nothing was allocated and no GC run before we started; the instance
+     * didn't exist. */
+    phase               = &trace->phases[trace->phases_num++];
+    phase->name         = "create instance";
+    phase->thread_id    = tc->thread_id;
+    phase->count        = 0;
+    phase->running      = 1;
+    phase->started.time = start_time;
+
+    tc->instance->startup_trace = trace;
+}
+
+/* Gets the name to use for a compilation unit as the subject of a phase.
+ * This is its filename, if it has one. */
+char * MVM_startup_trace_cu_name(MVMThreadContext *tc, MVMCompUnit *cu) {
+    char *name;
+    if (cu->body.filename)
+        return MVM_string_utf8_c8_encode_C_string(tc, cu->body.filename);
+    name = MVM_malloc(sizeof("<anonymous>"));
+    strcpy(name, "<anonymous>");
+    return name;
+}
+
+/* Adds a phase, started with the specified readings. Call with the mutex
+ * held. */
+static MVMint32 add_phase(MVMThreadContext *tc, MVMStartupTrace *trace, const char *name,
+                          char *subject, MVMStartupTraceCounters *started) {
+    MVMStartupTracePhase *phase;
+    unsigned int          interval_id = MVM_telemetry_interval_start(tc, name);
+    MVMint32              index;
+    if (subject)
+        MVM_telemetry_interval_annotate_dynamic((uintptr_t)tc, interval_id, subject);
+    MVM_VECTOR_ENSURE_SPACE(trace->phases, 1);
+    index              = (MVMint32)trace->phases_num++;
+    phase              = &trace->phases[index];
+    phase->name        = name;
+    phase->subject     = subject;
+    phase->thread_id   = tc->thread_id;
+    phase->running     = 1;
+    phase->interval_id = interval_id;
+    phase->first_start = started->time - trace->start_time;
+    phase->started     = *started;
+    return index;
+}
+
+/* Starts a phase, which is also a telemetry interval. The subject, if not
+ * NULL, is taken over by the trace. Returns the phase's index, to stop it
+ * with; 0 if tracing isn't on. */
+MVMint32 MVM_startup_trace_start(MVMThreadContext *tc, const char *name, char *subject) {
+    MVMStartupTrace        *trace = tc->instance->startup_trace;
+    MVMStartupTraceCounters started;
+    MVMint32                index;
+    if (!trace) {
+        MVM_free(subject);
+        return 0;
+    }
+    read_counters(tc, &started);
+    uv_mutex_lock(&trace->mutex);
+    index = add_phase(tc, trace, name, subject, &started);
+    uv_mutex_unlock(&trace->mutex);
+    return index;
+}
+
+/* Enters a phase that may be entered many times, perhaps by different
+ * threads, with what happens until it is next stopped added to its totals.
+ * The phase's index is kept in *phase (0 until it is first entered), which
+ * is only looked at and set with the mutex held. Resuming the phase does not
+ * start a telemetry interval; phases that are entered many times would flood
+ * the telemetry log. The subject is taken over by the trace, and is used if
+ * this starts the phase. Returns the index to stop the phase with, or -1 if
+ * tracing isn't on, or some other thread is in the phase now (in which case
+ * the time is counted there). */
+MVMint32 MVM_startup_trace_enter(MVMThreadContext *tc, MVMint32 *phase, const char *name, char *subject) {
+    MVMStartupTrace        *trace = tc->instance->startup_trace;
+    MVMStartupTraceCounters started;
+    MVMint32                index = -1;
+    if (!trace) {
+        MVM_free(subject);
+        return -1;
+    }
+    read_counters(tc, &started);
+    uv_mutex_lock(&trace->mutex);
+    if (!*phase) {
+        index  = add_phase(tc, trace, name, subject, &started);
+        *phase = index;
+        subject = NULL;
+    }
+    else if (!trace->phases[*phase].running) {
+        index = *phase;
+        trace->phases[index].running     = 1;
+        trace->phases[index].thread_id   = tc->thread_id;
+        trace->phases[index].interval_id = 0;
+        trace->phases[index].started     = started;
+    }
+    uv_mutex_unlock(&trace->mutex);
+    MVM_free(subject);
+    return index;
+}
+
+/* Stops a phase, adding what happened since it was started or entered to
+ * its totals. Only the thread that started or entered it can stop it, since
+ * the counters are per thread. */
+void MVM_startup_trace_stop(MVMThreadContext *tc, MVMint32 index) {
+    MVMStartupTrace        *trace = tc->instance->startup_trace;
+    MVMStartupTracePhase   *phase;
+    MVMStartupTraceCounters stopped;
+    if (!trace || index < 0)
+        return;
+    read_counters(tc, &stopped);
+    uv_mutex_lock(&trace->mutex);
+    phase = &trace->phases[index];
+    if (phase->running && phase->thread_id == tc->thread_id) {
+        add_counters(&phase->total, &phase->started, &stopped);
+        phase->count++;
+        phase->running = 0;
+        if (phase->interval_id)
+            MVM_telemetry_interval_stop(tc, phase->interval_id, phase->name);
+    }
+    uv_mutex_unlock(&trace->mutex);
+}
+
+/* Writes a string as a JSON string literal. */
+static void write_json_string(FILE *fh, const char *s) {
+    fputc('"', fh);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(fh, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(fh, "\\u%04x", c);
+        else
+            fputc(c, fh);
+    }
+    fputc('"', fh);
+}
+
+/* Writes the trace out as JSON. Phases that are still running (such as the
+ * load frame of a program that exits while running it) are written with what
+ * they did so far; for those on other threads, we can only know the time. */
+void MVM_startup_trace_write(MVMThreadContext *tc) {
+    MVMStartupTrace        *trace = tc->instance->startup_trace;
+    MVMStartupTraceCounters now;
+    FILE                   *fh;
+    size_t                  i;
+    if (!trace)
+        return;
+    fh = fopen(trace->filename, "w");
+    if (!fh)
+        return;
+    read_counters(tc, &now);
+
+    uv_mutex_lock(&trace->mutex);
+    fprintf(fh, "{\n  \"total_ns\": %"PRIu64",\n  \"phases\": [", now.time - trace->start_time);
+    for (i = 0; i < trace->phases_num; i++) {
+        MVMStartupTracePhase   *phase = &trace->phases[i];
+        MVMStartupTraceCounters total = phase->total;
+        if (phase->running) {
+            if (phase->thread_id == tc->thread_id)
+                add_counters(&total, &phase->started, &now);
+            else
+                total.time += now.time - phase->started.time;
+        }
+        fprintf(fh, "%s\n    {\"phase\": ", i ? "," : "");
+        write_json_string(fh, phase->name);
+        if (phase->subject) {
+            fprintf(fh, ", \"subject\": ");
+            write_json_string(fh, phase->subject);
+        }
+        fprintf(fh, ", \"thread\": %u, \"start_ns\": %"PRIu64", \"duration_ns\": %"PRIu64
+            ", \"count\": %u, \"complete\": %s, \"nursery_bytes\": %"PRIu64
+            ", \"gen2_bytes\": %"PRIu64", \"gc_runs\": %"PRIu64"}",
+            phase->thread_id, phase->first_start, total.time,
+            phase->count + phase->running, phase->running ? "false" : "true",
+            total.nursery_bytes, total.gen2_bytes, total.gc_runs);
+    }
+    fprintf(fh, "\n  ]\n}\n");
+    uv_mutex_unlock(&trace->mutex);
+    fclose(fh);
+}
+
+/* Frees the trace. */
+void MVM_startup_trace_destroy(MVMThreadContext *tc) {
+    MVMStartupTrace *trace = tc->instance->startup_trace;
+    size_t           i;
+    if (!trace)
+        return;
+    for (i = 0; i < trace->phases_num; i++)
+        MVM_free(trace->phases[i].subject);
+    MVM_VECTOR_DESTROY(trace->phases);
+    uv_mutex_destroy(&trace->mutex);
+    MVM_free(trace->filename);
+    MVM_free(trace);
+    tc->instance->startup_trace = NULL;
+}
@@ -0,0 +1,68 @@
+/* Counters we take a reading of at the start and end of a phase. */
+struct MVMStartupTraceCounters {
+    /* Wall time, in nanoseconds. */
+    MVMuint64 time;
+
+    /* Bytes allocated by the thread, in the nursery and directly in gen2. */
+    MVMuint64 nursery_bytes;
+    MVMuint64 gen2_bytes;
+
+    /* Number of GC runs. */
+    MVMuint64 gc_runs;
+};
+
+/* A phase of startup (or of loading a compilation unit later on) that we
+ * are timing. Some phases, such as validating the frames of a compilation
+ * unit, happen a little at a time; those are one phase that is entered
+ * again and again, with the totals accumulating. */
+struct MVMStartupTracePhase {
+    /* What the phase is doing, and what it is doing it to (such as the
+     * filename of a compilation unit; NULL if not applicable). */
+    const char *name;
+    char       *subject;
+
+    /* The thread that did the work. */
+    MVMuint32 thread_id;
+
+    /* How many times the phase was entered, and whether it is now. */
+    MVMuint32 count;
+    MVMuint32 running;
+
+    /* The telemetry interval of the current run of the phase. */
+    unsigned int interval_id;
+
+    /* When the phase was first entered, in nanoseconds since the instance
+     * was created. */
+    MVMuint64 first_start;
+
+    /* Readings from the current run of the phase, and the totals over all
+     * finished runs. */
+    MVMStartupTraceCounters started;
+    MVMStartupTraceCounters total;
+};
+
+/* Startup tracing, turned on by MVM_STARTUP_TRACE. We record the phases of
+ * creating the VM and loading compilation units, which the telemetry log
+ * also sees as intervals, and write them as JSON to a file at exit. */
+struct MVMStartupTrace {
+    /* The file to write the trace to. */
+    char *filename;
+
+    /* When the instance was created. */
+    MVMuint64 start_time;
+
+    /* The phases recorded, in the order they started, under a mutex. */
+    MVM_VECTOR_DECL(MVMStartupTracePhase, phases);
+    uv_mutex_t mutex;
+};
+
+/* The phase recording the creation of the instance, started by init. */
+#define MVM_STARTUP_TRACE_CREATE_INSTANCE 0
+
+void MVM_startup_trace_init(MVMThreadContext *tc, const char *filename, MVMuint64 start_time);
+char * MVM_startup_trace_cu_name(MVMThreadContext *tc, MVMCompUnit *cu);
+MVMint32 MVM_startup_trace_start(MVMThreadContext *tc, const char *name, char *subject);
+MVMint32 MVM_startup_trace_enter(MVMThreadContext *tc, MVMint32 *phase, const char *name, char *subject);
+void MVM_startup_trace_stop(MVMThreadContext *tc, MVMint32 phase);
+void MVM_startup_trace_write(MVMThreadContext *tc);
+void MVM_startup_trace_destroy(MVMThreadContext *tc);
@@ -57,7 +57,7 @@ MVMuint32 MVM_string_ascii_decodestream(MVMThreadContext *tc, MVMDecodeStream *d
         return 1;
 
     bufsize = ds->result_size_guess;
-    buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+    buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
 
     /* Decode each of the buffers. */
     cur_bytes = ds->bytes_head;
@@ -94,7 +94,7 @@ MVMuint32 MVM_string_ascii_decodestream(MVMThreadContext *tc, MVMDecodeStream *d
                 /* We filled the buffer. Attach this one to the buffers
                  * linked list, and continue with a new one. */
                 MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
-                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
                 count = 0;
             }
             buffer[count++] = graph;
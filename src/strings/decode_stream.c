@@ -28,10 +28,20 @@ MVMDecodeStream * MVM_string_decodestream_create(MVMThreadContext *tc, MVMint32
 
 /* Adds another byte buffer into the decoding stream. */
 void MVM_string_decodestream_add_bytes(MVMThreadContext *tc, MVMDecodeStream *ds, char *bytes, MVMint32 length) {
+    MVM_string_decodestream_add_pooled_bytes(tc, ds, bytes, length, 0);
+}
+
+/* Adds a byte buffer that came from the I/O buffer pool, of the specified
+ * pool size, into the decoding stream. It is given back to the pool rather
+ * than freed once it has been decoded. A pool size of zero means it is just
+ * a plain malloc'd buffer. */
+void MVM_string_decodestream_add_pooled_bytes(MVMThreadContext *tc, MVMDecodeStream *ds,
+        char *bytes, MVMint32 length, size_t pool_size) {
     if (length > 0) {
         MVMDecodeStreamBytes *new_bytes = MVM_calloc(1, sizeof(MVMDecodeStreamBytes));
-        new_bytes->bytes  = bytes;
-        new_bytes->length = length;
+        new_bytes->bytes     = bytes;
+        new_bytes->length    = length;
+        new_bytes->pool_size = pool_size;
         if (ds->bytes_tail)
             ds->bytes_tail->next = new_bytes;
         ds->bytes_tail = new_bytes;
@@ -40,7 +50,47 @@ void MVM_string_decodestream_add_bytes(MVMThreadContext *tc, MVMDecodeStream *ds
     }
     else {
         /* It's empty, so free the buffer right away and don't add. */
-        MVM_free(bytes);
+        if (pool_size)
+            MVM_io_buffer_pool_give(tc, bytes, pool_size);
+        else
+            MVM_free(bytes);
+    }
+}
+
+/* Frees a byte buffer and its holder, giving the buffer back to the I/O
+ * buffer pool if it came from there. */
+static void free_bytes(MVMThreadContext *tc, MVMDecodeStreamBytes *bytes) {
+    if (bytes->pool_size)
+        MVM_io_buffer_pool_give(tc, bytes->bytes, bytes->pool_size);
+    else
+        MVM_free(bytes->bytes);
+    MVM_free(bytes);
+}
+
+/* Allocates a buffer for a decoder to decode chars into. The decoder asks
+ * for a size, and gets a buffer of at least that size. If a chars buffer we
+ * have already taken everything out of is a close enough fit, it is used
+ * again instead of allocating; it's only re-used if it's not too much bigger,
+ * since buffers may end up owned by a string we produce. */
+MVMGrapheme32 * MVM_string_decodestream_alloc_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint32 size) {
+    MVMGrapheme32 *spare = ds->spare_chars;
+    if (spare && ds->spare_chars_size >= size && ds->spare_chars_size <= 2 * size) {
+        ds->spare_chars = NULL;
+        return spare;
+    }
+    return MVM_malloc(size * sizeof(MVMGrapheme32));
+}
+
+/* Internal function to free a chars buffer that we have taken everything out
+ * of, keeping it as the spare if it's the bigger one. */
+static void free_chars_buffer(MVMThreadContext *tc, MVMDecodeStream *ds, MVMGrapheme32 *chars, MVMint32 size) {
+    if (ds->spare_chars && ds->spare_chars_size >= size) {
+        MVM_free(chars);
+    }
+    else {
+        MVM_free(ds->spare_chars);
+        ds->spare_chars      = chars;
+        ds->spare_chars_size = size;
     }
 }
 
@@ -80,8 +130,7 @@ void MVM_string_decodestream_discard_to(MVMThreadContext *tc, MVMDecodeStream *d
         ds->abs_byte_pos += discard->length - ds->bytes_head_pos;
         ds->bytes_head = discard->next;
         ds->bytes_head_pos = 0;
-        MVM_free(discard->bytes);
-        MVM_free(discard);
+        free_bytes(tc, discard);
     }
     if (!ds->bytes_head && pos == 0)
         return;
@@ -91,8 +140,7 @@ void MVM_string_decodestream_discard_to(MVMThreadContext *tc, MVMDecodeStream *d
         ds->abs_byte_pos += discard->length - ds->bytes_head_pos;
         ds->bytes_head = discard->next;
         ds->bytes_head_pos = 0;
-        MVM_free(discard->bytes);
-        MVM_free(discard);
+        free_bytes(tc, discard);
         if (ds->bytes_head == NULL)
             ds->bytes_tail = NULL;
     }
@@ -222,7 +270,7 @@ static MVMString * take_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint3
                     result_found += to_copy;
                 }
                 found += available;
-                MVM_free(cur_chars->chars);
+                free_chars_buffer(tc, ds, cur_chars->chars, cur_chars->length);
                 free_chars(tc, ds, cur_chars);
                 ds->chars_head = next_chars;
                 ds->chars_head_pos = 0;
@@ -409,27 +457,26 @@ MVMString * MVM_string_decodestream_get_until_sep_eof(MVMThreadContext *tc, MVMD
     return MVM_string_decodestream_get_all(tc, ds);
 }
 
-/* Produces a string consisting of the characters available now in all decdoed
- * buffers. */
-static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds) {
-    MVMString *result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
-    result->body.storage_type = MVM_STRING_GRAPHEME_32;
+/* Takes all of the characters available now in all decoded buffers, handing
+ * back a single buffer of them (which the caller then owns) and setting the
+ * length. If there are none, returns NULL and sets length to zero. */
+static MVMGrapheme32 * take_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint32 *length_out) {
+    MVMGrapheme32 *result;
 
-    /* If there's no codepoint buffer, then return the empty string. */
+    /* If there's no codepoint buffer, then there's nothing to take. */
     if (!ds->chars_head) {
-        result->body.storage.blob_32 = NULL;
-        result->body.num_graphs      = 0;
+        result = NULL;
+        *length_out = 0;
     }
 
     /* If there's exactly one resulting codepoint buffer and we swallowed none
      * of it, just use it. */
     else if (ds->chars_head == ds->chars_tail && ds->chars_head_pos == 0) {
-        /* Set up result string. */
-        result->body.storage.blob_32 = ds->chars_head->chars;
-        result->body.num_graphs      = ds->chars_head->length;
+        result = ds->chars_head->chars;
+        *length_out = ds->chars_head->length;
 
         /* Don't free the buffer's memory itself, just the holder, as we
-         * stole that for the buffer into the string above. */
+         * stole that for the result above. */
         free_chars(tc, ds, ds->chars_head);
         ds->chars_head = ds->chars_tail = NULL;
     }
@@ -448,8 +495,8 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
         }
 
         /* Allocate a result buffer of the right size. */
-        result->body.storage.blob_32 = MVM_malloc(length * sizeof(MVMGrapheme32));
-        result->body.num_graphs      = length;
+        result = MVM_malloc(length * sizeof(MVMGrapheme32));
+        *length_out = length;
 
         /* Copy all the things into the target, freeing as we go. */
         cur_chars = ds->chars_head;
@@ -457,25 +504,190 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
             MVMDecodeStreamChars *next_chars = cur_chars->next;
             if (cur_chars == ds->chars_head) {
                 MVMint32 to_copy = ds->chars_head->length - ds->chars_head_pos;
-                memcpy(result->body.storage.blob_32 + pos, cur_chars->chars + ds->chars_head_pos,
+                memcpy(result + pos, cur_chars->chars + ds->chars_head_pos,
                     to_copy * sizeof(MVMGrapheme32));
                 pos += to_copy;
             }
             else {
-                memcpy(result->body.storage.blob_32 + pos, cur_chars->chars,
+                memcpy(result + pos, cur_chars->chars,
                     cur_chars->length * sizeof(MVMGrapheme32));
                 pos += cur_chars->length;
             }
-            MVM_free(cur_chars->chars);
+            free_chars_buffer(tc, ds, cur_chars->chars, cur_chars->length);
             free_chars(tc, ds, cur_chars);
             cur_chars = next_chars;
         }
         ds->chars_head = ds->chars_tail = NULL;
     }
+    ds->chars_head_pos = 0;
 
     return result;
 }
 
+/* Produces a string consisting of the characters available now in all decdoed
+ * buffers. */
+static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds) {
+    MVMString *result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    MVMint32   length;
+    result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+    result->body.storage.blob_32 = take_all_in_buffer(tc, ds, &length);
+    result->body.num_graphs      = length;
+    return result;
+}
+
+/* Scans for the first grapheme at or after pos that could be the final one
+ * of a separator, returning end if there is none. Lines are mostly made of
+ * graphemes above any separator's final grapheme, so we check blocks of them
+ * at a time with a branch-free comparison that the compiler can vectorize,
+ * only looking closer at a block when something in it might be interesting. */
+#define SEP_SCAN_BLOCK 16
+static MVMint32 scan_for_sep_final(MVMThreadContext *tc, const MVMGrapheme32 *chars,
+                                   MVMint32 pos, MVMint32 end, MVMDecodeStreamSeparators *sep_spec) {
+    MVMGrapheme32 max_final_grapheme = sep_spec->max_final_grapheme;
+    while (pos < end) {
+        MVMint32 block_end;
+        if (end - pos >= SEP_SCAN_BLOCK) {
+            MVMint32 i, maybe = 0;
+            for (i = 0; i < SEP_SCAN_BLOCK; i++)
+                maybe |= chars[pos + i] <= max_final_grapheme;
+            if (!maybe) {
+                pos += SEP_SCAN_BLOCK;
+                continue;
+            }
+            block_end = pos + SEP_SCAN_BLOCK;
+        }
+        else {
+            block_end = end;
+        }
+        for (; pos < block_end; pos++)
+            if (MVM_string_decode_stream_maybe_sep(tc, sep_spec, chars[pos]))
+                return pos;
+    }
+    return end;
+}
+
+/* Checks if a separator ends at the specified position, without starting
+ * before line_start. Returns the length of the separator if so, or 0 if not. */
+static MVMint32 sep_ending_at(MVMThreadContext *tc, const MVMGrapheme32 *chars, MVMint32 line_start,
+                              MVMint32 pos, MVMDecodeStreamSeparators *sep_spec) {
+    MVMint32 sep_graph_pos = 0;
+    MVMint32 i;
+    for (i = 0; i < sep_spec->num_seps; i++) {
+        MVMint32 sep_length = sep_spec->sep_lengths[i];
+        if (sep_length && pos + 1 - sep_length >= line_start &&
+                memcmp(chars + pos + 1 - sep_length, sep_spec->sep_graphemes + sep_graph_pos,
+                    sep_length * sizeof(MVMGrapheme32)) == 0)
+            return sep_length;
+        sep_graph_pos += sep_length;
+    }
+    return 0;
+}
+
+/* Makes a line string. Either it is a strand view over the shared blob that
+ * all lines from this batch come from, or it gets its own copy. */
+static MVMString * make_line(MVMThreadContext *tc, MVMString *blob, MVMGrapheme32 *chars,
+                             MVMint32 start, MVMint32 length) {
+    MVMString *line;
+    if (length == 0)
+        return tc->instance->str_consts.empty;
+    line = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    line->body.num_graphs = length;
+    if (blob) {
+        line->body.storage_type    = MVM_STRING_STRAND;
+        line->body.storage.strands = MVM_malloc(sizeof(MVMStringStrand));
+        line->body.num_strands     = 1;
+        line->body.storage.strands[0].blob_string = blob;
+        line->body.storage.strands[0].start       = start;
+        line->body.storage.strands[0].end         = start + length;
+        line->body.storage.strands[0].repetitions = 0;
+    }
+    else {
+        line->body.storage_type    = MVM_STRING_GRAPHEME_32;
+        line->body.storage.blob_32 = MVM_malloc(length * sizeof(MVMGrapheme32));
+        memcpy(line->body.storage.blob_32, chars + start, length * sizeof(MVMGrapheme32));
+    }
+    return line;
+}
+
+/* Decodes everything that is available and splits it into lines in a single
+ * pass, pushing them onto the native string array result, rather than doing
+ * a separator search and string allocation dance per line. A trailing partial
+ * line is left in the decode stream, unless eof is set, in which case it is
+ * taken too. If share_blob is set, the lines are all strand views onto one
+ * shared blob of the decoded chars, which saves copying at the cost of them
+ * keeping each other alive. Returns the number of lines taken. */
+MVMint64 MVM_string_decodestream_get_lines(MVMThreadContext *tc, MVMDecodeStream *ds,
+                                           MVMDecodeStreamSeparators *sep_spec, MVMObject *result,
+                                           MVMint32 chomp, MVMint32 eof, MVMint32 share_blob) {
+    MVMString *blob = NULL;
+    MVMGrapheme32 *chars;
+    MVMint32 length, pos, line_start;
+    MVMint64 taken = 0;
+
+    /* Decode all that we have, and grab it as a single buffer. */
+    if (eof)
+        reached_eof(tc, ds);
+    else if (ds->bytes_head)
+        run_decode(tc, ds, NULL, NULL, DECODE_NOT_EOF);
+    chars = take_all_in_buffer(tc, ds, &length);
+    if (!chars)
+        return 0;
+
+    /* If sharing, the blob string takes ownership of the buffer. */
+    if (share_blob) {
+        MVMROOT(tc, result, {
+            blob = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        });
+        blob->body.storage_type    = MVM_STRING_GRAPHEME_32;
+        blob->body.storage.blob_32 = chars;
+        blob->body.num_graphs      = length;
+    }
+
+    /* Scan for separators and produce the lines. */
+    pos = line_start = 0;
+    MVMROOT(tc, result, {
+    MVMROOT(tc, blob, {
+        while ((pos = scan_for_sep_final(tc, chars, pos, length, sep_spec)) < length) {
+            MVMint32 sep_length = sep_ending_at(tc, chars, line_start, pos, sep_spec);
+            pos++;
+            if (sep_length) {
+                MVMint32 line_length = pos - line_start - (chomp ? sep_length : 0);
+                MVM_repr_push_s(tc, result, make_line(tc, blob, chars, line_start, line_length));
+                line_start = pos;
+                taken++;
+            }
+        }
+        if (eof && line_start < length) {
+            MVM_repr_push_s(tc, result, make_line(tc, blob, chars, line_start, length - line_start));
+            line_start = length;
+            taken++;
+        }
+    });
+    });
+
+    /* Put any incomplete final line back into the decode stream (which has
+     * no decoded chars left in it now, so it goes at the start), re-using
+     * the buffer if we still own it. */
+    if (line_start < length) {
+        MVMint32 remaining = length - line_start;
+        MVMGrapheme32 *rest;
+        if (blob) {
+            rest = MVM_malloc(remaining * sizeof(MVMGrapheme32));
+            memcpy(rest, chars + line_start, remaining * sizeof(MVMGrapheme32));
+        }
+        else {
+            rest = chars;
+            memmove(rest, chars + line_start, remaining * sizeof(MVMGrapheme32));
+        }
+        MVM_string_decodestream_add_chars(tc, ds, rest, remaining);
+    }
+    else if (!blob) {
+        free_chars_buffer(tc, ds, chars, length);
+    }
+
+    return taken;
+}
+
 /* Decodes all the buffers, signals EOF to flush any normalization buffers, and
  * returns a string of all decoded chars. */
 MVMString * MVM_string_decodestream_get_all(MVMThreadContext *tc, MVMDecodeStream *ds) {
@@ -541,8 +753,7 @@ MVMint64 MVM_string_decodestream_bytes_to_buf(MVMThreadContext *tc, MVMDecodeStr
             taken += available;
             ds->bytes_head = cur_bytes->next;
             ds->bytes_head_pos = 0;
-            MVM_free(cur_bytes->bytes);
-            MVM_free(cur_bytes);
+            free_bytes(tc, cur_bytes);
         }
         else {
             /* Just take what we need. */
@@ -577,8 +788,7 @@ void MVM_string_decodestream_destroy(MVMThreadContext *tc, MVMDecodeStream *ds)
     MVMDecodeStreamChars *cur_chars = ds->chars_head;
     while (cur_bytes) {
         MVMDecodeStreamBytes *next_bytes = cur_bytes->next;
-        MVM_free(cur_bytes->bytes);
-        MVM_free(cur_bytes);
+        free_bytes(tc, cur_bytes);
         cur_bytes = next_bytes;
     }
     while (cur_chars) {
@@ -590,6 +800,7 @@ void MVM_string_decodestream_destroy(MVMThreadContext *tc, MVMDecodeStream *ds)
     MVM_unicode_normalizer_cleanup(tc, &(ds->norm));
     MVM_free(ds->decoder_state);
     MVM_free(ds->chars_reuse);
+    MVM_free(ds->spare_chars);
     MVM_free(ds);
 }
 
@@ -15,6 +15,11 @@ struct MVMDecodeStream {
      * have multiple free ones, so a free isn't worth the extra work.) */
     MVMDecodeStreamChars *chars_reuse;
 
+    /* Similarly, a chars buffer that we took everything out of, and its
+     * size, which decoders may get to decode into again. */
+    MVMGrapheme32 *spare_chars;
+    MVMint32 spare_chars_size;
+
     /* The byte position (for tell). */
     MVMint64 abs_byte_pos;
 
@@ -45,6 +50,9 @@ struct MVMDecodeStreamBytes {
     char                 *bytes;
     MVMint32              length;
     MVMDecodeStreamBytes *next;
+
+    /* If the bytes are an I/O buffer pool buffer, the size of it; else 0. */
+    size_t                pool_size;
 };
 
 /* A bunch of characters already decoded, with a link to the next bunch. */
@@ -96,11 +104,16 @@ MVM_STATIC_INLINE MVMint32 MVM_string_decode_stream_maybe_sep(MVMThreadContext *
 
 MVMDecodeStream * MVM_string_decodestream_create(MVMThreadContext *tc, MVMint32 encoding, MVMint64 abs_byte_pos, MVMint32 translate_newlines);
 void MVM_string_decodestream_add_bytes(MVMThreadContext *tc, MVMDecodeStream *ds, char *bytes, MVMint32 length);
+void MVM_string_decodestream_add_pooled_bytes(MVMThreadContext *tc, MVMDecodeStream *ds, char *bytes, MVMint32 length, size_t pool_size);
+MVMGrapheme32 * MVM_string_decodestream_alloc_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint32 size);
 void MVM_string_decodestream_add_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMGrapheme32 *chars, MVMint32 length);
 void MVM_string_decodestream_discard_to(MVMThreadContext *tc, MVMDecodeStream *ds, const MVMDecodeStreamBytes *bytes, MVMint32 pos);
 MVMString * MVM_string_decodestream_get_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint32 chars, MVMint64 eof);
 MVMString * MVM_string_decodestream_get_until_sep(MVMThreadContext *tc, MVMDecodeStream *ds, MVMDecodeStreamSeparators *seps, MVMint32 chomp);
 MVMString * MVM_string_decodestream_get_until_sep_eof(MVMThreadContext *tc, MVMDecodeStream *ds, MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp);
+MVMint64 MVM_string_decodestream_get_lines(MVMThreadContext *tc, MVMDecodeStream *ds,
+    MVMDecodeStreamSeparators *sep_spec, MVMObject *result, MVMint32 chomp, MVMint32 eof,
+    MVMint32 share_blob);
 MVMString * MVM_string_decodestream_get_all(MVMThreadContext *tc, MVMDecodeStream *ds);
 MVMString * MVM_string_decodestream_get_available(MVMThreadContext *tc, MVMDecodeStream *ds);
 MVMint64 MVM_string_decodestream_have_bytes(MVMThreadContext *tc, const MVMDecodeStream *ds, MVMint32 bytes);
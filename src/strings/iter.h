@@ -162,6 +162,12 @@ MVM_STATIC_INLINE MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadCont
             return a->body.storage.blob_8[index];
         case MVM_STRING_STRAND: {
             MVMGraphemeIter gi;
+            /* Single strand views (as produced by substring) can index
+             * straight into the blob they refer to. */
+            if (a->body.num_strands == 1 && a->body.storage.strands[0].repetitions == 0) {
+                MVMStringStrand *ss = a->body.storage.strands;
+                return MVM_string_get_grapheme_at_nocheck(tc, ss->blob_string, ss->start + index);
+            }
             MVM_string_gi_init(tc, &gi, a);
             MVM_string_gi_move_to(tc, &gi, index);
             return MVM_string_gi_get_grapheme(tc, &gi);
@@ -69,7 +69,7 @@ MVMuint32 MVM_string_latin1_decodestream(MVMThreadContext *tc, MVMDecodeStream *
         return 1;
 
     bufsize = ds->result_size_guess;
-    buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+    buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
 
     /* Decode each of the buffers. */
     cur_bytes = ds->bytes_head;
@@ -103,7 +103,7 @@ MVMuint32 MVM_string_latin1_decodestream(MVMThreadContext *tc, MVMDecodeStream *
                 /* We filled the buffer. Attach this one to the buffers
                  * linked list, and continue with a new one. */
                 MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
-                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
                 count = 0;
             }
             buffer[count++] = graph;
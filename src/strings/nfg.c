@@ -8,11 +8,19 @@
  * there is one, or negative if there is not (note 0 is a valid index). */
 static MVMint32 find_child_node_idx(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
     if (node) {
-        /* TODO: update this to do a binary search later on. */
-        MVMint32 i;
-        for (i = 0; i < node->num_entries; i++)
-            if (node->next_codes[i].code == cp)
-                return i;
+        /* Entries are sorted by codepoint, so binary search. */
+        MVMint32 lo = 0;
+        MVMint32 hi = node->num_entries - 1;
+        while (lo <= hi) {
+            MVMint32 mid = lo + (hi - lo) / 2;
+            MVMCodepoint mid_code = node->next_codes[mid].code;
+            if (mid_code == cp)
+                return mid;
+            else if (mid_code < cp)
+                lo = mid + 1;
+            else
+                hi = mid - 1;
+        }
     }
     return -1;
 }
@@ -221,11 +229,35 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
     return result;
 }
 
-/* Does a lookup of a synthetic in the trie. If we find one, returns it. If
- * not, acquires the update lock, re-checks that we really are missing the
- * synthetic, and then adds it. */
+/* Looks in the thread's synthetic cache for the codepoint sequence, hands
+ * back the cache entry it would live in (or NULL if it is too long to ever
+ * be cached). */
+static MVMNFGThreadCacheEntry * thread_cache_entry(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint32 hash = 0;
+    MVMint32  i;
+    if (num_codes > MVM_NFG_CACHE_MAX_CODES)
+        return NULL;
+    if (!tc->nfg_cache)
+        tc->nfg_cache = MVM_calloc(1, sizeof(MVMNFGThreadCache));
+    for (i = 0; i < num_codes; i++)
+        hash = (hash * 31) ^ (MVMuint32)codes[i];
+    hash ^= hash >> 16;
+    return &(tc->nfg_cache->entries[hash % MVM_NFG_CACHE_ENTRIES]);
+}
+static MVMint32 thread_cache_entry_matches(MVMNFGThreadCacheEntry *entry, MVMCodepoint *codes, MVMint32 num_codes) {
+    return entry->num_codes == num_codes &&
+        memcmp(entry->codes, codes, num_codes * sizeof(MVMCodepoint)) == 0;
+}
+
+/* Does a lookup of a synthetic in the thread's cache and then the trie. If we
+ * find one, returns it. If not, acquires the update lock, re-checks that we
+ * really are missing the synthetic, and then adds it. */
 static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
-    MVMGrapheme32 result = lookup_synthetic(tc, codes, num_codes);
+    MVMNFGThreadCacheEntry *entry = thread_cache_entry(tc, codes, num_codes);
+    MVMGrapheme32 result;
+    if (entry && thread_cache_entry_matches(entry, codes, num_codes))
+        return entry->synthetic;
+    result = lookup_synthetic(tc, codes, num_codes);
     if (!result) {
         uv_mutex_lock(&tc->instance->nfg->update_mutex);
         result = lookup_synthetic(tc, codes, num_codes);
@@ -233,6 +265,11 @@ static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint
             result = add_synthetic(tc, codes, num_codes, utf8_c8);
         uv_mutex_unlock(&tc->instance->nfg->update_mutex);
     }
+    if (entry) {
+        memcpy(entry->codes, codes, num_codes * sizeof(MVMCodepoint));
+        entry->num_codes = num_codes;
+        entry->synthetic = result;
+    }
     return result;
 }
 
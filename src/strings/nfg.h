@@ -76,6 +76,25 @@ struct MVMNFGTrieNodeEntry {
     MVMNFGTrieNode *node;
 };
 
+/* Per-thread cache of recently resolved codepoint sequence to synthetic
+ * mappings, so that repeatedly seen graphemes (think emoji-heavy or Indic
+ * text) do not need a walk of the trie. Synthetics are never removed, so a
+ * cached mapping never goes stale. It is direct-mapped on a hash of the
+ * codepoints, and only short sequences are cached. */
+#define MVM_NFG_CACHE_ENTRIES   32
+#define MVM_NFG_CACHE_MAX_CODES 4
+struct MVMNFGThreadCacheEntry {
+    /* The codepoints and how many there are (0 for an unused entry). */
+    MVMCodepoint codes[MVM_NFG_CACHE_MAX_CODES];
+    MVMint32 num_codes;
+
+    /* The synthetic they map to. */
+    MVMGrapheme32 synthetic;
+};
+struct MVMNFGThreadCache {
+    MVMNFGThreadCacheEntry entries[MVM_NFG_CACHE_ENTRIES];
+};
+
 /* The maximum number of codepoints we will allow in a synthetic grapheme.
  * This is a good bit higher than any real-world use case is going to run
  * in to. */
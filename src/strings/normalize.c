@@ -60,6 +60,13 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
     result_pos = 0;
     while (input_pos < input_codes) {
         MVMCodepoint cp;
+        MVMint64 produced;
+        maybe_grow_result(&result, &result_alloc, result_pos + (input_codes - input_pos) + 1);
+        input_pos += MVM_unicode_normalizer_process_stable_run(tc, &norm, input + input_pos,
+            input_codes - input_pos, result + result_pos, &produced);
+        result_pos += produced;
+        if (input_pos == input_codes)
+            break;
         ready = MVM_unicode_normalizer_process_codepoint(tc, &norm, input[input_pos], &cp);
         if (ready) {
             maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -101,6 +108,13 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
     result_pos = 0;
     while (input_pos < cp_count) {
         MVMGrapheme32 g;
+        MVMint64 produced;
+        maybe_grow_result(&result, &result_alloc, result_pos + (cp_count - input_pos) + 1);
+        input_pos += MVM_unicode_normalizer_process_stable_run(tc, &norm, cp_v + input_pos,
+            cp_count - input_pos, result + result_pos, &produced);
+        result_pos += produced;
+        if (input_pos == cp_count)
+            break;
         ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, cp_v[input_pos], &g);
         if (ready) {
             maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -664,6 +678,121 @@ static void grapheme_composition(MVMThreadContext *tc, MVMNormalizer *n, MVMint3
     }
 }
 
+/* Whether a codepoint is a "stable starter" for a normalization form: it
+ * passes the form's quick check, has a CCC of zero, is not a prepend and is
+ * not a control (so not a normalization terminator). Such codepoints never
+ * change in normalization and never interact with the codepoint before them,
+ * so can be handed straight back. Working that out needs several property
+ * lookups, so for the BMP we cache the answers in a bitmap per form, filled
+ * lazily a block of 256 codepoints at a time. The bitmap is shared between
+ * threads; a racing reader that sees the block flagged as computed but not
+ * yet its bits just sees "not stable", and takes the (correct) slow path. */
+#define STABLE_BITMAP_LIMIT     0x10000
+#define STABLE_BITMAP_BLOCK     256
+#define STABLE_BITMAP_FORMS     5
+static MVMuint32 stable_bitmap[STABLE_BITMAP_FORMS][STABLE_BITMAP_LIMIT / 32];
+static MVMuint8  stable_bitmap_computed[STABLE_BITMAP_FORMS][STABLE_BITMAP_LIMIT / STABLE_BITMAP_BLOCK];
+static MVMint32 stable_bitmap_index(MVMNormalization form) {
+    switch (form) {
+        case MVM_NORMALIZE_NFD:  return 0;
+        case MVM_NORMALIZE_NFKD: return 1;
+        case MVM_NORMALIZE_NFC:  return 2;
+        case MVM_NORMALIZE_NFKC: return 3;
+        default:                 return 4;
+    }
+}
+static MVMint32 compute_stable_starter(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    if (cp < 0x20 || (0x7F <= cp && cp <= 0x9F) || cp == 0xAD)
+        return 0;
+    if (is_grapheme_prepend(tc, cp))
+        return 0;
+    if (cp > 0xFF && MVM_string_is_control_full(tc, cp))
+        return 0;
+    return passes_quickcheck(tc, n, cp) && MVM_unicode_relative_ccc(tc, cp) == 0;
+}
+static MVMint32 is_stable_starter(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    MVMint32 form_idx, block;
+    if (cp < 0 || cp >= STABLE_BITMAP_LIMIT)
+        return cp > 0 && compute_stable_starter(tc, n, cp);
+    form_idx = stable_bitmap_index(n->form);
+    block    = cp / STABLE_BITMAP_BLOCK;
+    if (!stable_bitmap_computed[form_idx][block]) {
+        MVMuint32 bits[STABLE_BITMAP_BLOCK / 32];
+        MVMCodepoint first = block * STABLE_BITMAP_BLOCK;
+        MVMint32 i;
+        memset(bits, 0, sizeof(bits));
+        for (i = 0; i < STABLE_BITMAP_BLOCK; i++)
+            if (compute_stable_starter(tc, n, first + i))
+                bits[i / 32] |= 1u << (i % 32);
+        memcpy(stable_bitmap[form_idx] + first / 32, bits, sizeof(bits));
+        MVM_barrier();
+        stable_bitmap_computed[form_idx][block] = 1;
+    }
+    return (stable_bitmap[form_idx][cp / 32] >> (cp % 32)) & 1;
+}
+
+/* Block-level fast path. Given a run of input codepoints, hands as many of
+ * them as possible straight to out, without going through the per-codepoint
+ * machinery, provided they and whatever is held in the normalizer are stable
+ * starters. When composing, the last stable codepoint of the run is kept in
+ * the normalization buffer, since the next one may combine with it. Returns
+ * the number of input codepoints consumed (0 if the fast path didn't apply),
+ * and sets *produced to the number of codepoints written to out, which must
+ * have space for num_in + 1 of them. */
+MVMint64 MVM_unicode_normalizer_process_stable_run(MVMThreadContext *tc, MVMNormalizer *n,
+        const MVMCodepoint *in, MVMint64 num_in, MVMCodepoint *out, MVMint64 *produced) {
+    MVMint64 held = n->buffer_end - n->buffer_start;
+    MVMint64 run  = 0;
+    MVMint64 i;
+    *produced = 0;
+
+    /* Only applies if nothing is being normalized right now, or if we're
+     * composing and just one stable starter is held back. */
+    if (n->prepend_buffer || n->buffer_norm_end != n->buffer_start)
+        return 0;
+    if (held > (MVM_NORMALIZE_COMPOSE(n->form) ? 1 : 0))
+        return 0;
+    if (held && !is_stable_starter(tc, n, n->buffer[n->buffer_start]))
+        return 0;
+
+    /* Find the run of stable starters. Printable ASCII is stable in all
+     * forms, so we needn't consult the bitmap for it. */
+    while (run < num_in) {
+        MVMCodepoint cp = in[run];
+        if (cp >= 0x20 && cp < 0x7F)
+            run++;
+        else if (is_stable_starter(tc, n, cp))
+            run++;
+        else
+            break;
+    }
+    if (!run)
+        return 0;
+
+    if (MVM_NORMALIZE_COMPOSE(n->form)) {
+        /* Emit what was held plus all but the last of the run, which we now
+         * hold on to instead. */
+        MVMint64 out_pos = 0;
+        if (held)
+            out[out_pos++] = n->buffer[n->buffer_start];
+        for (i = 0; i < run - 1; i++)
+            out[out_pos++] = in[i];
+        if (held) {
+            n->buffer[n->buffer_start] = in[run - 1];
+        }
+        else {
+            add_codepoint_to_buffer(tc, n, in[run - 1]);
+        }
+        *produced = out_pos;
+    }
+    else {
+        /* Decomposing; stable starters go out as they are. */
+        memcpy(out, in, run * sizeof(MVMCodepoint));
+        *produced = run;
+    }
+    return run;
+}
+
 /* Called when the very fast case of normalization fails (that is, when we get
  * any two codepoints in a row where at least one is greater than the first
  * significant codepoint identified by a quick check for the target form). We
@@ -671,7 +800,8 @@ static void grapheme_composition(MVMThreadContext *tc, MVMNormalizer *n, MVMint3
  * compute the normalization. */
 MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVMNormalizer *norm, MVMCodepoint in, MVMCodepoint *out) {
     MVMint64 qc_in, ccc_in;
-    int is_prepend = is_grapheme_prepend(tc, in);
+    int is_stable  = is_stable_starter(tc, norm, in);
+    int is_prepend = is_stable ? 0 : is_grapheme_prepend(tc, in);
 
     if (0 < norm->prepend_buffer)
         norm->prepend_buffer--;
@@ -680,13 +810,14 @@ MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVM
 
     /* If it's a control character (outside of the range we checked in the
      * fast path) then it's a normalization terminator. */
-    if (in > 0xFF && MVM_string_is_control_full(tc, in) && !is_prepend) {
+    if (!is_stable && in > 0xFF && MVM_string_is_control_full(tc, in) && !is_prepend) {
         return MVM_unicode_normalizer_process_codepoint_norm_terminator(tc, norm, in, out);
     }
 
-    /* Do a quickcheck on the codepoint we got in and get its CCC. */
-    qc_in  = passes_quickcheck(tc, norm, in);
-    ccc_in = MVM_unicode_relative_ccc(tc, in);
+    /* Do a quickcheck on the codepoint we got in and get its CCC; we already
+     * know the answers for stable starters. */
+    qc_in  = is_stable || passes_quickcheck(tc, norm, in);
+    ccc_in = is_stable ? 0 : MVM_unicode_relative_ccc(tc, in);
     /* Fast cases when we pass quick check and what we got in has CCC = 0,
      * and it does not follow a prepend character. */
     if (qc_in && ccc_in == 0 && norm->prepend_buffer == 0) {
@@ -700,7 +831,8 @@ MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVM
              * so we're safe. */
             if (norm->buffer_end - norm->buffer_start == 1) {
                 MVMCodepoint maybe_result = norm->buffer[norm->buffer_start];
-                if (passes_quickcheck(tc, norm, maybe_result) && MVM_unicode_relative_ccc(tc, maybe_result) == 0) {
+                if (is_stable_starter(tc, norm, maybe_result) || (passes_quickcheck(tc, norm, maybe_result)
+                        && MVM_unicode_relative_ccc(tc, maybe_result) == 0)) {
                     *out = norm->buffer[norm->buffer_start];
                     norm->buffer[norm->buffer_start] = in;
                     return 1;
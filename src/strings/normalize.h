@@ -134,6 +134,10 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint_to_grapheme(
     return MVM_unicode_normalizer_process_codepoint(tc, n, in, (MVMGrapheme32 *)out);
 }
 
+/* Block-level fast path for runs of codepoints that need no normalization. */
+MVMint64 MVM_unicode_normalizer_process_stable_run(MVMThreadContext *tc, MVMNormalizer *n,
+    const MVMCodepoint *in, MVMint64 num_in, MVMCodepoint *out, MVMint64 *produced);
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints);
 
@@ -507,6 +507,28 @@ MVMint64 MVM_string_index_from_end(MVMThreadContext *tc, MVMString *Haystack, MV
     return result;
 }
 
+/* Decides whether a substring of the given length should be copied into a
+ * fresh flat buffer rather than being a strand view onto the source. Tiny
+ * slices are cheaper to copy than to reference. Slices that are only a small
+ * fraction of the blob they come from would, as views, keep the whole blob
+ * alive (think of lines split out of a big file), so we copy those too. Big
+ * slices of a blob become single strand views, which the grapheme accessors
+ * fast-path. */
+#define MVM_SUBSTRING_COPY_MAX_GRAPHS   64
+#define MVM_SUBSTRING_VIEW_MIN_RATIO    4
+static MVMint32 substring_should_copy(MVMThreadContext *tc, MVMString *a, MVMint64 length) {
+    MVMString *blob;
+    if (length <= MVM_SUBSTRING_COPY_MAX_GRAPHS)
+        return 1;
+    if (a->body.storage_type != MVM_STRING_STRAND)
+        blob = a;
+    else if (a->body.num_strands == 1 && a->body.storage.strands[0].repetitions == 0)
+        blob = a->body.storage.strands[0].blob_string;
+    else
+        return 0; /* Gets collapsed into a flat string anyway. */
+    return length * MVM_SUBSTRING_VIEW_MIN_RATIO < (MVMint64)blob->body.num_graphs;
+}
+
 /* Returns a substring of the given string */
 MVMString * MVM_string_substring(MVMThreadContext *tc, MVMString *a, MVMint64 offset, MVMint64 length) {
     MVMString *result;
@@ -552,7 +574,16 @@ MVMString * MVM_string_substring(MVMThreadContext *tc, MVMString *a, MVMint64 of
     MVMROOT(tc, a, {
         result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
         result->body.num_graphs = end_pos - start_pos;
-        if (a->body.storage_type != MVM_STRING_STRAND) {
+        if (substring_should_copy(tc, a, end_pos - start_pos)) {
+            /* Small slice, or a small part of a big blob. Copy it into its
+             * own compact storage, so we don't pin the (potentially huge)
+             * source buffer in memory and accesses need no strand walk. */
+            MVMGraphemeIter gi;
+            MVM_string_gi_init(tc, &gi, a);
+            MVM_string_gi_move_to(tc, &gi, start_pos);
+            iterate_gi_into_string(tc, &gi, result);
+        }
+        else if (a->body.storage_type != MVM_STRING_STRAND) {
             /* It's some kind of buffer. Construct a strand view into it. */
             result->body.storage_type    = MVM_STRING_STRAND;
             result->body.storage.strands = allocate_strands(tc, 1);
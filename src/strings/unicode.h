@@ -22,5 +22,25 @@ struct MVMUnicodeGraphemeNameRegistry {
     UT_hash_handle hash_handle;
 };
 
+/* Per-thread cache of recently computed collation sort keys, so that a sort
+ * asking for the key of the same string more than once computes it once. It
+ * is direct-mapped, holds the strings it caches keys for (marked as roots of
+ * the thread), and only keeps short keys. */
+#define MVM_COLLATION_KEY_CACHE_ENTRIES   64
+#define MVM_COLLATION_KEY_CACHE_MAX_BYTES 256
+struct MVMCollationKeyCacheEntry {
+    /* The string and collation mode the key is for. */
+    MVMString *string;
+    MVMint64   collation_mode;
+
+    /* The key and its length in bytes. */
+    MVMuint8  *key;
+    MVMuint64  length;
+};
+struct MVMCollationKeyCache {
+    MVMCollationKeyCacheEntry entries[MVM_COLLATION_KEY_CACHE_ENTRIES];
+};
+void MVM_unicode_collation_key_cache_destroy(MVMThreadContext *tc);
+
 void MVM_unicode_init(MVMThreadContext *tc);
 void MVM_unicode_release(MVMThreadContext *tc);
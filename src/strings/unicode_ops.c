@@ -679,6 +679,303 @@ MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMStrin
     return collation_return_by_quaternary(tc, &level_eval_settings, alen, blen, compare_by_cp_rtrn);
 }
 
+/* Collation sort keys. Rather than walking the collation tables for both
+ * strings on every comparison, a sort key is computed once per string, and
+ * two keys compare with memcmp the same way the strings collate. The key is
+ * laid out level by level, as in UCA section 7.3: all non-ignorable primary
+ * weights as 16 bit big-endian values, a level separator, then the secondary
+ * weights, a separator, the tertiary weights, and finally the codepoints
+ * themselves to break ties at the quaternary level. Levels which are not
+ * enabled in `collation_mode` are left out. A reversed level stores each
+ * weight complemented and uses a separator that sorts after any weight, so a
+ * string which is a prefix of another sorts last on that level. */
+struct key_buf {
+    MVMuint8  *bytes;
+    MVMuint64  used;
+    MVMuint64  alloc;
+};
+typedef struct key_buf key_buf;
+#define initial_key_buf_size 64
+MVM_STATIC_INLINE void key_buf_append(key_buf *buf, MVMuint32 value, MVMint32 num_bytes) {
+    if (buf->alloc < buf->used + num_bytes) {
+        buf->alloc *= 2;
+        buf->bytes  = MVM_realloc(buf->bytes, buf->alloc);
+    }
+    while (num_bytes--)
+        buf->bytes[buf->used++] = (value >> (8 * num_bytes)) & 0xFF;
+}
+/* Returns 1 if the level is sorted normally, -1 if it is reversed, and 0 if
+ * it is disabled (including when both directions were asked for, since those
+ * cancel out in MVM_unicode_string_compare too). */
+MVM_STATIC_INLINE MVMint32 collation_level_direction(MVMint64 collation_mode, MVMint32 level) {
+    return (collation_mode & (1 << (2 * level))     ? 1 : 0)
+         - (collation_mode & (1 << (2 * level + 1)) ? 1 : 0);
+}
+static void append_collation_level(key_buf *buf, collation_stack *stack, MVMint32 level, MVMint32 direction) {
+    MVMint64 i;
+    for (i = 0; i <= stack->stack_top; i++) {
+        /* Values on the stack are one higher than the DUCET ones, with
+         * collation_zero being ignorable at this level. */
+        MVMuint32 weight = stack->keys[i].a[level];
+        if (weight <= collation_zero)
+            continue;
+        weight = weight - 1 < 0xFFFF ? weight - 1 : 0xFFFF;
+        key_buf_append(buf, direction < 0 ? 0xFFFF - weight : weight, 2);
+    }
+    key_buf_append(buf, direction < 0 ? 0xFFFF : 0x0000, 2);
+}
+
+/* Collation elements for ASCII, computed on first use, so that strings made
+ * up of ASCII alone can skip the codepoint iterator, the normalizer and the
+ * search through the UCA tables. A codepoint that begins a contraction, or
+ * does not map to exactly one collation element, is marked as unusable and
+ * sends the string down the general path. */
+struct ascii_collation_element {
+    MVMuint32 primary, secondary, tertiary;
+    MVMuint32 usable;
+};
+static struct ascii_collation_element ascii_collation_elements[0x80];
+static volatile MVMuint32 ascii_collation_elements_ready = 0;
+static void compute_ascii_collation_elements(MVMThreadContext *tc) {
+    MVMCodepoint cp;
+    for (cp = 0; cp < 0x80; cp++) {
+        struct ascii_collation_element *e = &ascii_collation_elements[cp];
+        MVMint64 node = get_main_node(tc, cp, 0, starter_main_nodes_elems);
+        e->usable = 0;
+        if (node != -1) {
+            if (main_nodes[node].sub_node_elems == 0 && main_nodes[node].collation_key_elems == 1) {
+                struct collation_key key = special_collation_keys[main_nodes[node].collation_key_link];
+                e->primary   = key.primary   + 1;
+                e->secondary = key.secondary + 1;
+                e->tertiary  = key.tertiary  + 1;
+                e->usable    = 1;
+            }
+        }
+        else if (!is_Block_Tangut(cp)) {
+            e->primary   = MVM_unicode_collation_primary(tc, cp);
+            e->secondary = MVM_unicode_collation_secondary(tc, cp);
+            e->tertiary  = MVM_unicode_collation_tertiary(tc, cp);
+            e->usable    = 0 < e->primary && 0 < e->secondary && 0 < e->tertiary;
+        }
+    }
+    /* Any thread racing us computes the very same table, so all we need is
+     * for the values to be visible before the flag is. */
+    MVM_barrier();
+    ascii_collation_elements_ready = 1;
+}
+/* Pushes the collation elements of an ASCII-only string onto the stack and
+ * returns 1. Returns 0, leaving the stack empty, if the string needs the
+ * general path. */
+static MVMint32 push_ascii_collation_elements(MVMThreadContext *tc, MVMString *s, collation_stack *stack) {
+    MVMGraphemeIter gi;
+    MVMStringIndex graphs = MVM_string_graphs_nocheck(tc, s), i;
+    if (!ascii_collation_elements_ready)
+        compute_ascii_collation_elements(tc);
+    MVM_string_gi_init(tc, &gi, s);
+    for (i = 0; i < graphs; i++) {
+        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
+        if (g < 0 || 0x7F < g || !ascii_collation_elements[g].usable) {
+            stack->stack_top = -1;
+            return 0;
+        }
+        push_key_to_stack(stack, ascii_collation_elements[g].primary,
+            ascii_collation_elements[g].secondary, ascii_collation_elements[g].tertiary);
+    }
+    return 1;
+}
+
+/* Computes the sort key of a string for the given collation_mode (see the top
+ * of this file for its values). Returns a buffer the caller must free, and
+ * stores its size in bytes into `length`. */
+MVMuint8 * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s,
+        MVMint64 collation_mode, MVMuint64 *length) {
+    collation_stack stack;
+    key_buf buf;
+    MVMint32 level, direction, is_ascii;
+    MVM_string_check_arg(tc, s, "collation key");
+    init_stack(tc, &stack);
+    buf.bytes = MVM_malloc(initial_key_buf_size);
+    buf.used  = 0;
+    buf.alloc = initial_key_buf_size;
+
+    /* Gather the collation elements for the whole string. */
+    is_ascii = push_ascii_collation_elements(tc, s, &stack);
+    if (!is_ascii) {
+        MVMCodepointIter ci;
+        MVM_string_ci_init(tc, &ci, s, 0, 0);
+        while (grab_from_stack(tc, &ci, &stack, "key"))
+            ;
+    }
+    DEBUG_PRINT_STACK(tc, &stack, "key", "MVM_unicode_string_collation_key()");
+
+    /* Primary, secondary and tertiary levels. */
+    for (level = 0; level < 3; level++) {
+        direction = collation_level_direction(collation_mode, level);
+        if (direction)
+            append_collation_level(&buf, &stack, level, direction);
+    }
+    cleanup_stack(tc, &stack);
+
+    /* Ties are broken by codepoint, at three bytes a codepoint. If reversed,
+     * a terminator sorts a prefix after the strings it is a prefix of; the
+     * reversed codepoints are one lower than their complement, so that none
+     * of them (not even that of U+0000) can be taken for the terminator. */
+    direction = collation_level_direction(collation_mode, 3);
+    if (direction) {
+        MVMCodepointIter ci;
+        MVM_string_ci_init(tc, &ci, s, 0, 0);
+        while (MVM_string_ci_has_more(tc, &ci)) {
+            MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
+            key_buf_append(&buf, direction < 0 ? 0xFFFFFE - cp : cp, 3);
+        }
+        if (direction < 0)
+            key_buf_append(&buf, 0xFFFFFF, 3);
+    }
+
+    *length = buf.used;
+    return buf.bytes;
+}
+
+#ifdef MVM_COLLATION_KEY_CHECK
+/* MoarVM has no test suite of its own, so this is the test that sort keys
+ * order strings the same way MVM_unicode_string_compare does. Build with
+ * MVM_COLLATION_KEY_CHECK defined and it runs the first time each thread
+ * makes a sort key, going through every pair of a set of strings picked to
+ * poke at the edges of the key format (empty strings, prefixes, U+0000 and
+ * the highest codepoint, case and accents, non-ASCII) in every collation_mode,
+ * that is with each level disabled, normal or reversed. It panics on the
+ * first disagreement. */
+struct collation_key_sample {
+    const char *utf8;
+    size_t      bytes;
+};
+#define KEY_SAMPLE(s) { s, sizeof(s) - 1 }
+static const struct collation_key_sample collation_key_samples[] = {
+    KEY_SAMPLE(""), KEY_SAMPLE("a"), KEY_SAMPLE("A"), KEY_SAMPLE("b"),
+    KEY_SAMPLE("ab"), KEY_SAMPLE("aB"), KEY_SAMPLE("abc"), KEY_SAMPLE("a b"),
+    KEY_SAMPLE("a-b"), KEY_SAMPLE("\0"), KEY_SAMPLE("a\0"), KEY_SAMPLE("\0a"),
+    KEY_SAMPLE("a\0\0"), KEY_SAMPLE("\xC3\xA1"), KEY_SAMPLE("\xC3\x81"),
+    KEY_SAMPLE("\xC3\xA1" "b"), KEY_SAMPLE("\xC3\xA6"), KEY_SAMPLE("\xC3\x9F"),
+    KEY_SAMPLE("ss"), KEY_SAMPLE("resume"), KEY_SAMPLE("r\xC3\xA9sum\xC3\xA9"),
+    KEY_SAMPLE("R\xC3\xA9sum\xC3\xA9"), KEY_SAMPLE("\xE4\xB8\x80"),
+    KEY_SAMPLE("\xF0\x9F\x98\x80"), KEY_SAMPLE("\xF4\x8F\xBF\xBF"),
+    KEY_SAMPLE("a\xF4\x8F\xBF\xBF")
+};
+#define NUM_KEY_SAMPLES (sizeof(collation_key_samples) / sizeof(struct collation_key_sample))
+static MVMint64 compare_collation_keys(MVMuint8 *a, MVMuint64 a_length, MVMuint8 *b, MVMuint64 b_length) {
+    int r = memcmp(a, b, a_length < b_length ? a_length : b_length);
+    if (r)
+        return r < 0 ? -1 : 1;
+    return a_length < b_length ? -1 : b_length < a_length ? 1 : 0;
+}
+static void check_collation_keys(MVMThreadContext *tc) {
+    MVMString *strings[NUM_KEY_SAMPLES];
+    MVMuint32  i, j, mode, level;
+    for (i = 0; i < NUM_KEY_SAMPLES; i++) {
+        strings[i] = MVM_string_utf8_decode(tc, tc->instance->VMString,
+            collation_key_samples[i].utf8, collation_key_samples[i].bytes);
+        MVM_gc_root_temp_push(tc, (MVMCollectable **)&(strings[i]));
+    }
+    /* Each of the four levels is disabled (0), normal (1) or reversed (2). */
+    for (mode = 0; mode < 81; mode++) {
+        MVMint64  collation_mode = 0;
+        MVMuint32 m = mode;
+        for (level = 0; level < 4; level++, m /= 3)
+            if (m % 3)
+                collation_mode |= (MVMint64)1 << (2 * level + m % 3 - 1);
+        for (i = 0; i < NUM_KEY_SAMPLES; i++) {
+            MVMuint64 a_length;
+            MVMuint8 *a = MVM_unicode_string_collation_key(tc, strings[i], collation_mode, &a_length);
+            for (j = 0; j < NUM_KEY_SAMPLES; j++) {
+                MVMuint64 b_length;
+                MVMuint8 *b = MVM_unicode_string_collation_key(tc, strings[j], collation_mode, &b_length);
+                MVMint64 by_key  = compare_collation_keys(a, a_length, b, b_length);
+                MVMint64 by_unicmp = MVM_unicode_string_compare(tc, strings[i], strings[j],
+                    collation_mode, 0, 0);
+                MVM_free(b);
+                if (by_key != by_unicmp)
+                    MVM_panic(1, "Collation keys of samples %u and %u compare as %"PRIi64
+                        " but unicmp_s gives %"PRIi64", with collation_mode %"PRIi64,
+                        i, j, by_key, by_unicmp, collation_mode);
+            }
+            MVM_free(a);
+        }
+    }
+    MVM_gc_root_temp_pop_n(tc, NUM_KEY_SAMPLES);
+}
+#endif
+
+/* Looks for a string's sort key in the per-thread cache, computing and
+ * caching it if needed. Entries are found by the string's identity, not its
+ * contents, and are slotted by its hash code, which survives the string being
+ * moved by the GC. Returns a buffer the caller must free. */
+static MVMuint8 * cached_collation_key(MVMThreadContext *tc, MVMString *s,
+        MVMint64 collation_mode, MVMuint64 *length) {
+    MVMCollationKeyCacheEntry *entry;
+    MVMuint8 *key;
+    if (!tc->collation_key_cache) {
+        tc->collation_key_cache = MVM_calloc(1, sizeof(MVMCollationKeyCache));
+#ifdef MVM_COLLATION_KEY_CHECK
+        MVMROOT(tc, s, {
+            check_collation_keys(tc);
+        });
+#endif
+    }
+    if (!s->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, s);
+    entry = &(tc->collation_key_cache->entries[
+        ((MVMuint32)s->body.cached_hash_code ^ (MVMuint32)collation_mode) % MVM_COLLATION_KEY_CACHE_ENTRIES]);
+    if (entry->string != s || entry->collation_mode != collation_mode) {
+        key = MVM_unicode_string_collation_key(tc, s, collation_mode, length);
+        if (*length <= MVM_COLLATION_KEY_CACHE_MAX_BYTES) {
+            MVM_free(entry->key);
+            entry->key            = MVM_malloc(*length);
+            entry->length         = *length;
+            entry->collation_mode = collation_mode;
+            entry->string         = s;
+            memcpy(entry->key, key, *length);
+        }
+        return key;
+    }
+    key = MVM_malloc(entry->length);
+    memcpy(key, entry->key, entry->length);
+    *length = entry->length;
+    return key;
+}
+
+/* Writes the sort key of a string into an empty native uint8 array, and
+ * returns the array. Keys written this way for the same collation_mode can
+ * be compared bytewise in place of calling MVM_unicode_string_compare. */
+MVMObject * MVM_unicode_string_collation_key_to_buf(MVMThreadContext *tc, MVMString *s,
+        MVMint64 collation_mode, MVMObject *buf) {
+    MVMuint64 length;
+    MVMuint8 *key;
+    MVM_string_check_arg(tc, s, "unicollkey");
+    if (!IS_CONCRETE(buf) || REPR(buf)->ID != MVM_REPR_ID_VMArray
+            || !STABLE(buf)->REPR_data
+            || ((MVMArrayREPRData *)STABLE(buf)->REPR_data)->slot_type != MVM_ARRAY_U8)
+        MVM_exception_throw_adhoc(tc, "unicollkey requires a native uint8 array to write into");
+    if (((MVMArray *)buf)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "unicollkey requires an empty array");
+    key = cached_collation_key(tc, s, collation_mode, &length);
+    ((MVMArray *)buf)->body.slots.u8 = key;
+    ((MVMArray *)buf)->body.start    = 0;
+    ((MVMArray *)buf)->body.ssize    = length;
+    ((MVMArray *)buf)->body.elems    = length;
+    return buf;
+}
+
+/* Frees a thread's collation key cache. */
+void MVM_unicode_collation_key_cache_destroy(MVMThreadContext *tc) {
+    if (tc->collation_key_cache) {
+        MVMint32 i;
+        for (i = 0; i < MVM_COLLATION_KEY_CACHE_ENTRIES; i++)
+            MVM_free(tc->collation_key_cache->entries[i].key);
+        MVM_free(tc->collation_key_cache);
+        tc->collation_key_cache = NULL;
+    }
+}
+
 /* Looks up a codepoint by name. Lazily constructs a hash. */
 MVMGrapheme32 MVM_unicode_lookup_by_name(MVMThreadContext *tc, MVMString *name) {
     MVMuint64 size;
@@ -1,4 +1,8 @@
 MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b,
     MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode);
+MVMuint8 * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s,
+    MVMint64 collation_mode, MVMuint64 *length);
+MVMObject * MVM_unicode_string_collation_key_to_buf(MVMThreadContext *tc, MVMString *s,
+    MVMint64 collation_mode, MVMObject *buf);
 
 MVMString * MVM_unicode_string_from_name(MVMThreadContext *tc, MVMString *name);
@@ -152,7 +152,7 @@ MVMuint32 MVM_string_windows1252_decodestream(MVMThreadContext *tc, MVMDecodeStr
         return 1;
 
     bufsize = ds->result_size_guess;
-    buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+    buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
 
     /* Decode each of the buffers. */
     cur_bytes = ds->bytes_head;
@@ -186,7 +186,7 @@ MVMuint32 MVM_string_windows1252_decodestream(MVMThreadContext *tc, MVMDecodeStr
                 /* We filled the buffer. Attach this one to the buffers
                  * linked list, and continue with a new one. */
                 MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
-                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                buffer = MVM_string_decodestream_alloc_chars(tc, ds, bufsize);
                 count = 0;
             }
             buffer[count++] = graph;
@@ -24,6 +24,7 @@ typedef struct MVMCode MVMCode;
 typedef struct MVMCodeBody MVMCodeBody;
 typedef struct MVMCollectable MVMCollectable;
 typedef struct MVMCompUnit MVMCompUnit;
+typedef struct MVMCompUnitMapping MVMCompUnitMapping;
 typedef struct MVMCompUnitBody MVMCompUnitBody;
 typedef struct MVMConcatState MVMConcatState;
 typedef struct MVMContainerConfigurer MVMContainerConfigurer;
@@ -74,10 +75,18 @@ typedef struct MVMKnowHOWREPR MVMKnowHOWREPR;
 typedef struct MVMKnowHOWREPRBody MVMKnowHOWREPRBody;
 typedef struct MVMLexicalRegistry MVMLexicalRegistry;
 typedef struct MVMLoadedCompUnitName MVMLoadedCompUnitName;
+typedef struct MVMMASTCache MVMMASTCache;
+typedef struct MVMMASTCacheEntry MVMMASTCacheEntry;
+typedef struct MVMMethodTable MVMMethodTable;
+typedef struct MVMMethodTableSlot MVMMethodTableSlot;
 typedef struct MVMNFA MVMNFA;
 typedef struct MVMNFABody MVMNFABody;
 typedef struct MVMNFAStateInfo MVMNFAStateInfo;
 typedef struct MVMNFGState MVMNFGState;
+typedef struct MVMNFGThreadCache MVMNFGThreadCache;
+typedef struct MVMNFGThreadCacheEntry MVMNFGThreadCacheEntry;
+typedef struct MVMCollationKeyCache MVMCollationKeyCache;
+typedef struct MVMCollationKeyCacheEntry MVMCollationKeyCacheEntry;
 typedef struct MVMNFGSynthetic MVMNFGSynthetic;
 typedef struct MVMNFGTrieNode MVMNFGTrieNode;
 typedef struct MVMNFGTrieNodeEntry MVMNFGTrieNodeEntry;
@@ -126,6 +135,8 @@ typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
 typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
 typedef struct MVMConcBlockingQueueLocks MVMConcBlockingQueueLocks;
+typedef struct MVMConcBlockingQueueSlot MVMConcBlockingQueueSlot;
+typedef struct MVMConcBlockingQueueREPRData MVMConcBlockingQueueREPRData;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -158,6 +169,7 @@ typedef struct MVMSerializationContext MVMSerializationContext;
 typedef struct MVMSerializationContextBody MVMSerializationContextBody;
 typedef struct MVMSerializationReader MVMSerializationReader;
 typedef struct MVMDeserializeWorklist MVMDeserializeWorklist;
+typedef struct MVMSerializationPreload MVMSerializationPreload;
 typedef struct MVMSerializationRoot MVMSerializationRoot;
 typedef struct MVMSerializationWriter MVMSerializationWriter;
 typedef struct MVMSpeshGraph MVMSpeshGraph;
@@ -193,6 +205,9 @@ typedef struct MVMSpeshPlan MVMSpeshPlan;
 typedef struct MVMSpeshPlanned MVMSpeshPlanned;
 typedef struct MVMSpeshArgGuard MVMSpeshArgGuard;
 typedef struct MVMSpeshArgGuardNode MVMSpeshArgGuardNode;
+typedef struct MVMStartupTrace MVMStartupTrace;
+typedef struct MVMStartupTraceCounters MVMStartupTraceCounters;
+typedef struct MVMStartupTracePhase MVMStartupTracePhase;
 typedef struct MVMSTable MVMSTable;
 typedef struct MVMStaticFrame MVMStaticFrame;
 typedef struct MVMStaticFrameBody MVMStaticFrameBody;
@@ -213,10 +228,12 @@ typedef struct MVMUnicodeNamedValue MVMUnicodeNamedValue;
 typedef struct MVMUnicodeNameRegistry MVMUnicodeNameRegistry;
 typedef struct MVMUnicodeGraphemeNameRegistry MVMUnicodeGraphemeNameRegistry;
 typedef struct MVMUninstantiable MVMUninstantiable;
+typedef struct MVMValidationCache MVMValidationCache;
 typedef struct MVMWorkThread MVMWorkThread;
 typedef struct MVMIOOps MVMIOOps;
 typedef struct MVMIOClosable MVMIOClosable;
 typedef struct MVMIOSyncReadable MVMIOSyncReadable;
+typedef struct MVMIOFileSendable MVMIOFileSendable;
 typedef struct MVMIOSyncWritable MVMIOSyncWritable;
 typedef struct MVMIOAsyncReadable MVMIOAsyncReadable;
 typedef struct MVMIOAsyncWritable MVMIOAsyncWritable;
@@ -225,6 +242,12 @@ typedef struct MVMIOSeekable MVMIOSeekable;
 typedef struct MVMIOSockety MVMIOSockety;
 typedef struct MVMIOIntrospection MVMIOIntrospection;
 typedef struct MVMIOLockable MVMIOLockable;
+typedef struct MVMIOBufferPool MVMIOBufferPool;
+typedef struct MVMIOUring MVMIOUring;
+typedef struct MVMIOUringOp MVMIOUringOp;
+typedef struct MVMEventLoop MVMEventLoop;
+typedef struct MVMEventLoopAfterSetup MVMEventLoopAfterSetup;
+typedef struct MVMEventLoopSubmission MVMEventLoopSubmission;
 typedef struct MVMDecodeStream MVMDecodeStream;
 typedef struct MVMDecodeStreamBytes MVMDecodeStreamBytes;
 typedef struct MVMDecodeStreamChars MVMDecodeStreamChars;